@@ -70,12 +70,26 @@ function spine.play_anim(url, anim_id, playback, options, callback_function) end
 ---@param options? spine.cancel.options Cancel options
 function spine.cancel(url, options) end
 
+---Decodes an animation ahead of playing it. Only has an effect when the `spine.lazy_animations`
+---project setting is enabled and the spine scene uses binary skeleton data.
+---@param url string|hash|url The Spine model using the animation
+---@param anim_id string|hash Id of the animation to decode
+function spine.prefetch_anim(url, anim_id) end
+
 ---Returns the id of the game object that corresponds to a specified skeleton bone.
 ---@param url string|hash|url The Spine model to query
 ---@param bone_id hash Id of the corresponding bone
 ---@return hash id Id of the game object
 function spine.get_go(url, bone_id) end
 
+---Returns the world transforms of one or more bones, as of the last update of the spine model.
+---This doesn't require the "Create Go Bones" option. Pass a table of vmath.matrix4 or a buffer as result to avoid creating garbage every frame.
+---@param url string|hash|url The Spine model to query
+---@param bone_ids string|hash|table A bone id, or a table of bone ids
+---@param result? table|buffer A table of vmath.matrix4, or a buffer with a float32 stream named "transform" with 16 components per bone, to write the transforms into
+---@return matrix4|table|buffer transforms The transform if a single bone id was given, otherwise a table of transforms. If result was given, it is returned
+function spine.get_bone_transforms(url, bone_ids, result) end
+
 ---Sets the spine skin on a spine model.
 ---@param url string|hash|url The Spine model to query
 ---@param skin string|hash Id of the corresponding skin
@@ -182,6 +182,11 @@ function gui.set_spine_attachment(node, slot, attachment) end
 ---@param color vector4 target color.
 function gui.set_spine_slot_color(node, slot, color) end
 
+---This is only useful for spine nodes. Sets a rectangle, in the coordinate space of the node's parent, outside of which the node is not rendered. The animation still updates while the node is culled.
+---@param node node spine node to set the cull rect for
+---@param rect vector4|nil visible area as (x, y, width, height), or nil to disable culling
+function gui.set_spine_cull_rect(node, rect) end
+
 ---Apply a physics-based translation to the Spine GUI node.
 ---@param node node The Spine GUI node to translate.
 ---@param translation vector3 The translation vector to apply to the Spine GUI node.
@@ -230,3 +235,16 @@ function gui.set_spine_ik_target(node, ik_constraint_id, target_node) end
 ---end
 ---```
 function gui.reset_spine_ik_target(node, ik_constraint_id) end
+
+---@class gui.get_spine_stats.stats
+---@field bone_updates number number of bone nodes whose transform was updated
+---@field nodes number number of spine nodes rendered
+---@field vertices number number of vertices generated for the spine nodes
+---@field batch_break_texture number number of spine nodes that use a different atlas than the spine node drawn before them
+---@field batch_break_blend_mode number number of spine nodes that use a different blend mode than the spine node drawn before them
+---@field batch_break_clipping number number of spine nodes that are clippers
+---@field slot_blend_overrides number number of slots drawn with the blend mode of their node, instead of the blend mode set in Spine
+
+---Returns statistics about the spine nodes of the current gui scene, for the last completed frame.
+---@return gui.get_spine_stats.stats stats table with the statistics
+function gui.get_spine_stats() end
@@ -26,3 +26,18 @@ resource = {}
 ---@param options resource.create_spinescene.options Table with spine_data and atlas_path fields
 ---@return hash path_hash canonical path hash of the created resource
 function resource.create_spinescene(path, options) end
+
+---@class resource.create_spinescene_async.options
+---@field spine_data string|buffer|nil JSON or binary bytes of the Spine skeleton
+---@field spine_file string|nil Or, a file to read the Spine skeleton from (e.g. a downloaded file)
+---@field atlas_path string Path to the compiled atlas resource (.texturesetc)
+
+---Creates a spinescene resource (.spinescenec) from runtime data, without blocking.
+---Same as resource.create_spinescene(), except that the Spine data is parsed on a
+---separate thread. The data may be given as a string or a buffer (which is copied once),
+---or read from a file by the thread. The resource is created, and the callback is
+---called, on the main thread once the parsing is done.
+---@param path string The target resource path. Must end with .spinescenec
+---@param options resource.create_spinescene_async.options Table with spine_data or spine_file, and atlas_path fields
+---@param callback fun(self: userdata, path_hash: hash|nil, error: string|nil) Called when the resource is created, or failed to be created
+function resource.create_spinescene_async(path, options, callback) end
@@ -178,6 +178,46 @@ float spTimeline_getDuration(const spTimeline *self) {
 #define CURVE_BEZIER 2
 #define BEZIER_SIZE 18
 
+/* Defold: with compact curves, a bezier is stored as its 4 control values (cx1, cy1, cx2, cy2) instead of
+ * its 9 sampled points. The points are sampled with the same code when the curve is evaluated, so the
+ * result is identical to the float path, at less than a quarter of the memory. */
+#define BEZIER_COMPACT_SIZE 4
+
+static int _spCompactCurves = 0;
+
+void spCurveTimeline_setCompactCurves(int compact) {
+	_spCompactCurves = compact;
+}
+
+static int _spCurveTimeline_bezierSize(const spCurveTimeline *self) {
+	return self->compact ? BEZIER_COMPACT_SIZE : BEZIER_SIZE;
+}
+
+static void _spCurveTimeline_sampleBezier(float *curves, float time1, float value1, float cx1, float cy1, float cx2,
+										  float cy2, float time2, float value2) {
+	float tmpx, tmpy, dddx, dddy, ddx, ddy, dx, dy, x, y;
+	int i;
+	tmpx = (time1 - cx1 * 2 + cx2) * 0.03;
+	tmpy = (value1 - cy1 * 2 + cy2) * 0.03;
+	dddx = ((cx1 - cx2) * 3 - time1 + time2) * 0.006;
+	dddy = ((cy1 - cy2) * 3 - value1 + value2) * 0.006;
+	ddx = tmpx * 2 + dddx;
+	ddy = tmpy * 2 + dddy;
+	dx = (cx1 - time1) * 0.3 + tmpx + dddx * 0.16666667;
+	dy = (cy1 - value1) * 0.3 + tmpy + dddy * 0.16666667;
+	x = time1 + dx, y = value1 + dy;
+	for (i = 0; i < BEZIER_SIZE; i += 2) {
+		curves[i] = x;
+		curves[i + 1] = y;
+		dx += ddx;
+		dy += ddy;
+		ddx += dddx;
+		ddy += dddy;
+		x += dx;
+		y += dy;
+	}
+}
+
 void _spCurveTimeline_init(spCurveTimeline *self,
 						   int frameCount,
 						   int frameEntries,
@@ -194,8 +234,9 @@ void _spCurveTimeline_init(spCurveTimeline *self,
 											 float cx2, float cy2, float time2, float value2)) {
 	_spTimeline_init(SUPER(self), frameCount, frameEntries, propertyIds, propertyIdsCount, type, dispose, apply,
 					 setBezier);
-	self->curves = spFloatArray_create(frameCount + bezierCount * BEZIER_SIZE);
-	self->curves->size = frameCount + bezierCount * BEZIER_SIZE;
+	self->compact = _spCompactCurves;
+	self->curves = spFloatArray_create(frameCount + bezierCount * _spCurveTimeline_bezierSize(self));
+	self->curves->size = frameCount + bezierCount * _spCurveTimeline_bezierSize(self);
 	self->curves->items[frameCount - 1] = CURVE_STEPPED;
 }
 
@@ -206,10 +247,29 @@ void _spCurveTimeline_dispose(spTimeline *self) {
 void _spCurveTimeline_setBezier(spTimeline *timeline, int bezier, int frame, float value, float time1, float value1,
 								float cx1, float cy1, float cx2, float cy2, float time2, float value2) {
 	spCurveTimeline *self = SUB_CAST(spCurveTimeline, timeline);
-	float tmpx, tmpy, dddx, dddy, ddx, ddy, dx, dy, x, y;
-	int i = self->super.frameCount + bezier * BEZIER_SIZE, n;
+	int i = self->super.frameCount + bezier * _spCurveTimeline_bezierSize(self);
 	float *curves = self->curves->items;
 	if (value == 0) curves[frame] = CURVE_BEZIER + i;
+	if (self->compact) {
+		/* time1, value1, time2 and value2 are the frame values, which are read back when sampling */
+		curves[i] = cx1;
+		curves[i + 1] = cy1;
+		curves[i + 2] = cx2;
+		curves[i + 3] = cy2;
+		return;
+	}
+	_spCurveTimeline_sampleBezier(curves + i, time1, value1, cx1, cy1, cx2, cy2, time2, value2);
+}
+
+/* Defold: samples the points the same way as _spCurveTimeline_sampleBezier, but stops at the one we need */
+static float _spCurveTimeline_getCompactBezierValue(spCurveTimeline *self, float time, int frameIndex, int valueOffset, int i) {
+	float *curves = self->curves->items;
+	float *frames = SUPER(self)->frames->items;
+	int next = frameIndex + self->super.frameEntries;
+	float time1 = frames[frameIndex], value1 = frames[frameIndex + valueOffset];
+	float time2 = frames[next], value2 = frames[next + valueOffset];
+	float cx1 = curves[i], cy1 = curves[i + 1], cx2 = curves[i + 2], cy2 = curves[i + 3];
+	float tmpx, tmpy, dddx, dddy, ddx, ddy, dx, dy, x, y, px, py;
 	tmpx = (time1 - cx1 * 2 + cx2) * 0.03;
 	tmpy = (value1 - cy1 * 2 + cy2) * 0.03;
 	dddx = ((cx1 - cx2) * 3 - time1 + time2) * 0.006;
@@ -219,16 +279,18 @@ void _spCurveTimeline_setBezier(spTimeline *timeline, int bezier, int frame, flo
 	dx = (cx1 - time1) * 0.3 + tmpx + dddx * 0.16666667;
 	dy = (cy1 - value1) * 0.3 + tmpy + dddy * 0.16666667;
 	x = time1 + dx, y = value1 + dy;
-	for (n = i + BEZIER_SIZE; i < n; i += 2) {
-		curves[i] = x;
-		curves[i + 1] = y;
+	if (x > time) return value1 + (time - time1) / (x - time1) * (y - value1);
+	for (i = 2; i < BEZIER_SIZE; i += 2) {
+		px = x, py = y;
 		dx += ddx;
 		dy += ddy;
 		ddx += dddx;
 		ddy += dddy;
 		x += dx;
 		y += dy;
+		if (x >= time) return py + (time - px) / (x - px) * (y - py);
 	}
+	return y + (time - x) / (time2 - x) * (value2 - y);
 }
 
 float _spCurveTimeline_getBezierValue(spCurveTimeline *self, float time, int frameIndex, int valueOffset, int i) {
@@ -236,6 +298,7 @@ float _spCurveTimeline_getBezierValue(spCurveTimeline *self, float time, int fra
 	float *frames = SUPER(self)->frames->items;
 	float x, y;
 	int n;
+	if (self->compact) return _spCurveTimeline_getCompactBezierValue(self, time, frameIndex, valueOffset, i);
 	if (curves[i] > time) {
 		x = frames[frameIndex];
 		y = frames[frameIndex + valueOffset];
@@ -493,7 +556,7 @@ void _spTranslateTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, floa
 		default: {
 			x = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE1, curveType - CURVE_BEZIER);
 			y = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE2,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) - CURVE_BEZIER);
 		}
 	}
 
@@ -702,7 +765,7 @@ void _spScaleTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 		default: {
 			x = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE1, curveType - CURVE_BEZIER);
 			y = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE2,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) - CURVE_BEZIER);
 		}
 	}
 	x *= bone->data->scaleX;
@@ -886,7 +949,7 @@ void _spShearTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 		default: {
 			x = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE1, curveType - CURVE_BEZIER);
 			y = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE2,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) - CURVE_BEZIER);
 		}
 	}
 
@@ -1047,11 +1110,11 @@ void _spRGBATimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float las
 		default: {
 			r = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_R, curveType - CURVE_BEZIER);
 			g = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_G,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) - CURVE_BEZIER);
 			b = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_B,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 2 - CURVE_BEZIER);
 			a = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_A,
-												curveType + BEZIER_SIZE * 3 - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 3 - CURVE_BEZIER);
 		}
 	}
 	color = &slot->color;
@@ -1148,9 +1211,9 @@ void _spRGBTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float last
 		default: {
 			r = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_R, curveType - CURVE_BEZIER);
 			g = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_G,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) - CURVE_BEZIER);
 			b = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_B,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 2 - CURVE_BEZIER);
 		}
 	}
 	color = &slot->color;
@@ -1329,17 +1392,17 @@ void _spRGBA2Timeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 		default: {
 			r = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_R, curveType - CURVE_BEZIER);
 			g = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_G,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) - CURVE_BEZIER);
 			b = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_B,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 2 - CURVE_BEZIER);
 			a = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_A,
-												curveType + BEZIER_SIZE * 3 - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 3 - CURVE_BEZIER);
 			r2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_R2,
-												 curveType + BEZIER_SIZE * 4 - CURVE_BEZIER);
+												 curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 4 - CURVE_BEZIER);
 			g2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_G2,
-												 curveType + BEZIER_SIZE * 5 - CURVE_BEZIER);
+												 curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 5 - CURVE_BEZIER);
 			b2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_B2,
-												 curveType + BEZIER_SIZE * 6 - CURVE_BEZIER);
+												 curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 6 - CURVE_BEZIER);
 		}
 	}
 
@@ -1464,15 +1527,15 @@ void _spRGB2Timeline_apply(spTimeline *timeline, spSkeleton *skeleton, float las
 		default: {
 			r = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_R, curveType - CURVE_BEZIER);
 			g = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_G,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) - CURVE_BEZIER);
 			b = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_B,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 2 - CURVE_BEZIER);
 			r2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR2_R2,
-												 curveType + BEZIER_SIZE * 3 - CURVE_BEZIER);
+												 curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 3 - CURVE_BEZIER);
 			g2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR2_G2,
-												 curveType + BEZIER_SIZE * 4 - CURVE_BEZIER);
+												 curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 4 - CURVE_BEZIER);
 			b2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR2_B2,
-												 curveType + BEZIER_SIZE * 5 - CURVE_BEZIER);
+												 curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 5 - CURVE_BEZIER);
 		}
 	}
 
@@ -1598,19 +1661,15 @@ void spAttachmentTimeline_setFrame(spAttachmentTimeline *self, int frame, float
 
 /**/
 
-void _spDeformTimeline_setBezier(spTimeline *timeline, int bezier, int frame, float value, float time1, float value1,
-								 float cx1, float cy1,
-								 float cx2, float cy2, float time2, float value2) {
-	spDeformTimeline *self = SUB_CAST(spDeformTimeline, timeline);
-	int n, i = self->super.super.frameCount + bezier * BEZIER_SIZE;
-	float *curves = self->super.curves->items;
+static void _spDeformTimeline_sampleBezier(float *curves, float time1, float cx1, float cy1, float cx2, float cy2,
+										   float time2) {
+	int i;
 	float tmpx = (time1 - cx1 * 2 + cx2) * 0.03, tmpy = cy2 * 0.03 - cy1 * 0.06;
 	float dddx = ((cx1 - cx2) * 3 - time1 + time2) * 0.006, dddy = (cy1 - cy2 + 0.33333333) * 0.018;
 	float ddx = tmpx * 2 + dddx, ddy = tmpy * 2 + dddy;
 	float dx = (cx1 - time1) * 0.3 + tmpx + dddx * 0.16666667, dy = cy1 * 0.3 + tmpy + dddy * 0.16666667;
 	float x = time1 + dx, y = dy;
-	if (value == 0) curves[frame] = CURVE_BEZIER + i;
-	for (n = i + BEZIER_SIZE; i < n; i += 2) {
+	for (i = 0; i < BEZIER_SIZE; i += 2) {
 		curves[i] = x;
 		curves[i + 1] = y;
 		dx += ddx;
@@ -1620,11 +1679,53 @@ void _spDeformTimeline_setBezier(spTimeline *timeline, int bezier, int frame, fl
 		x += dx;
 		y += dy;
 	}
+}
+
+void _spDeformTimeline_setBezier(spTimeline *timeline, int bezier, int frame, float value, float time1, float value1,
+								 float cx1, float cy1,
+								 float cx2, float cy2, float time2, float value2) {
+	spDeformTimeline *self = SUB_CAST(spDeformTimeline, timeline);
+	int i = self->super.super.frameCount + bezier * _spCurveTimeline_bezierSize(SUPER(self));
+	float *curves = self->super.curves->items;
+	if (value == 0) curves[frame] = CURVE_BEZIER + i;
+	if (self->super.compact) {
+		curves[i] = cx1;
+		curves[i + 1] = cy1;
+		curves[i + 2] = cx2;
+		curves[i + 3] = cy2;
+	} else {
+		_spDeformTimeline_sampleBezier(curves + i, time1, cx1, cy1, cx2, cy2, time2);
+	}
 
 	UNUSED(value1);
 	UNUSED(value2);
 }
 
+/* Defold: see _spCurveTimeline_getCompactBezierValue */
+static float _spDeformTimeline_getCompactCurvePercent(spDeformTimeline *self, float time, int frame, int i) {
+	float *curves = self->super.curves->items;
+	float *frames = self->super.super.frames->items;
+	float time1 = frames[frame], time2 = frames[frame + self->super.super.frameEntries];
+	float cx1 = curves[i], cy1 = curves[i + 1], cx2 = curves[i + 2], cy2 = curves[i + 3];
+	float tmpx = (time1 - cx1 * 2 + cx2) * 0.03, tmpy = cy2 * 0.03 - cy1 * 0.06;
+	float dddx = ((cx1 - cx2) * 3 - time1 + time2) * 0.006, dddy = (cy1 - cy2 + 0.33333333) * 0.018;
+	float ddx = tmpx * 2 + dddx, ddy = tmpy * 2 + dddy;
+	float dx = (cx1 - time1) * 0.3 + tmpx + dddx * 0.16666667, dy = cy1 * 0.3 + tmpy + dddy * 0.16666667;
+	float x = time1 + dx, y = dy, px, py;
+	if (x > time) return y * (time - time1) / (x - time1);
+	for (i = 2; i < BEZIER_SIZE; i += 2) {
+		px = x, py = y;
+		dx += ddx;
+		dy += ddy;
+		ddx += dddx;
+		ddy += dddy;
+		x += dx;
+		y += dy;
+		if (x >= time) return py + (time - px) / (x - px) * (y - py);
+	}
+	return y + (1 - y) * (time - x) / (time2 - x);
+}
+
 float _spDeformTimeline_getCurvePercent(spDeformTimeline *self, float time, int frame) {
 	float *curves = self->super.curves->items;
 	float *frames = self->super.super.frames->items;
@@ -1643,6 +1744,7 @@ float _spDeformTimeline_getCurvePercent(spDeformTimeline *self, float time, int
 		}
 	}
 	i -= CURVE_BEZIER;
+	if (self->super.compact) return _spDeformTimeline_getCompactCurvePercent(self, time, frame, i);
 	if (curves[i] > time) {
 		x = frames[frame];
 		return curves[i + 1] * (time - x) / (curves[i] - x);
@@ -2260,7 +2362,7 @@ void _spIkConstraintTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, f
 		default: {
 			mix = _spCurveTimeline_getBezierValue(SUPER(self), time, i, IKCONSTRAINT_MIX, curveType - CURVE_BEZIER);
 			softness = _spCurveTimeline_getBezierValue(SUPER(self), time, i, IKCONSTRAINT_SOFTNESS,
-													   curveType + BEZIER_SIZE - CURVE_BEZIER);
+													   curveType + _spCurveTimeline_bezierSize(SUPER(self)) - CURVE_BEZIER);
 		}
 	}
 
@@ -2398,15 +2500,15 @@ void _spTransformConstraintTimeline_apply(spTimeline *timeline, spSkeleton *skel
 			rotate = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_ROTATE,
 													 curveType - CURVE_BEZIER);
 			x = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_X,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) - CURVE_BEZIER);
 			y = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_Y,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 2 - CURVE_BEZIER);
 			scaleX = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_SCALEX,
-													 curveType + BEZIER_SIZE * 3 - CURVE_BEZIER);
+													 curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 3 - CURVE_BEZIER);
 			scaleY = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_SCALEY,
-													 curveType + BEZIER_SIZE * 4 - CURVE_BEZIER);
+													 curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 4 - CURVE_BEZIER);
 			shearY = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_SHEARY,
-													 curveType + BEZIER_SIZE * 5 - CURVE_BEZIER);
+													 curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 5 - CURVE_BEZIER);
 		}
 	}
 
@@ -2593,9 +2695,9 @@ void _spPathConstraintMixTimeline_apply(spTimeline *timeline, spSkeleton *skelet
 			rotate = _spCurveTimeline_getBezierValue(SUPER(self), time, i, PATHCONSTRAINTMIX_ROTATE,
 													 curveType - CURVE_BEZIER);
 			x = _spCurveTimeline_getBezierValue(SUPER(self), time, i, PATHCONSTRAINTMIX_X,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) - CURVE_BEZIER);
 			y = _spCurveTimeline_getBezierValue(SUPER(self), time, i, PATHCONSTRAINTMIX_Y,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
+												curveType + _spCurveTimeline_bezierSize(SUPER(self)) * 2 - CURVE_BEZIER);
 		}
 	}
 
@@ -2860,3 +2962,87 @@ spPhysicsConstraintResetTimeline *spPhysicsConstraintResetTimeline_create(int fr
 void spPhysicsConstraintResetTimeline_setFrame(spPhysicsConstraintResetTimeline *self, int frame, float time) {
 	self->super.frames->items[frame] = time;
 }
+
+/* Defold: the vtable is stored by value in each timeline, so timelines copied from another process (see
+ * dmSpine::LoadSkeletonBlob) get their function pointers back from the type. Returns 0 for an unknown type. */
+int _spTimeline_restoreVtable(spTimeline *self) {
+	void (*apply)(spTimeline *self, spSkeleton *skeleton, float lastTime, float time, spEvent **firedEvents,
+				  int *eventsCount, float alpha, spMixBlend blend, spMixDirection direction) = 0;
+	void (*dispose)(spTimeline *self) = _spCurveTimeline_dispose;
+	void (*setBezier)(spTimeline *self, int bezier, int frame, float value, float time1, float value1, float cx1,
+					  float cy1, float cx2, float cy2, float time2, float value2) = _spCurveTimeline_setBezier;
+
+	switch (self->type) {
+		case SP_TIMELINE_ROTATE: apply = _spRotateTimeline_apply; break;
+		case SP_TIMELINE_TRANSLATE: apply = _spTranslateTimeline_apply; break;
+		case SP_TIMELINE_TRANSLATEX: apply = _spTranslateXTimeline_apply; break;
+		case SP_TIMELINE_TRANSLATEY: apply = _spTranslateYTimeline_apply; break;
+		case SP_TIMELINE_SCALE: apply = _spScaleTimeline_apply; break;
+		case SP_TIMELINE_SCALEX: apply = _spScaleXTimeline_apply; break;
+		case SP_TIMELINE_SCALEY: apply = _spScaleYTimeline_apply; break;
+		case SP_TIMELINE_SHEAR: apply = _spShearTimeline_apply; break;
+		case SP_TIMELINE_SHEARX: apply = _spShearXTimeline_apply; break;
+		case SP_TIMELINE_SHEARY: apply = _spShearYTimeline_apply; break;
+		case SP_TIMELINE_RGBA: apply = _spRGBATimeline_apply; break;
+		case SP_TIMELINE_RGB: apply = _spRGBTimeline_apply; break;
+		case SP_TIMELINE_ALPHA: apply = _spAlphaTimeline_apply; break;
+		case SP_TIMELINE_RGBA2: apply = _spRGBA2Timeline_apply; break;
+		case SP_TIMELINE_RGB2: apply = _spRGB2Timeline_apply; break;
+		case SP_TIMELINE_IKCONSTRAINT: apply = _spIkConstraintTimeline_apply; break;
+		case SP_TIMELINE_TRANSFORMCONSTRAINT: apply = _spTransformConstraintTimeline_apply; break;
+		case SP_TIMELINE_PATHCONSTRAINTPOSITION: apply = _spPathConstraintPositionTimeline_apply; break;
+		case SP_TIMELINE_PATHCONSTRAINTSPACING: apply = _spPathConstraintSpacingTimeline_apply; break;
+		case SP_TIMELINE_PATHCONSTRAINTMIX: apply = _spPathConstraintMixTimeline_apply; break;
+		case SP_TIMELINE_PHYSICSCONSTRAINT_INERTIA:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_STRENGTH:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_DAMPING:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_MASS:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_WIND:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_GRAVITY:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_MIX:
+			apply = _spPhysicsConstraintTimeline_apply;
+			break;
+		case SP_TIMELINE_DEFORM:
+			apply = _spDeformTimeline_apply;
+			dispose = _spDeformTimeline_dispose;
+			setBezier = _spDeformTimeline_setBezier;
+			break;
+		case SP_TIMELINE_ATTACHMENT:
+			apply = _spAttachmentTimeline_apply;
+			dispose = _spAttachmentTimeline_dispose;
+			setBezier = 0;
+			break;
+		case SP_TIMELINE_SEQUENCE:
+			apply = _spSequenceTimeline_apply;
+			dispose = _spSequenceTimeline_dispose;
+			setBezier = 0;
+			break;
+		case SP_TIMELINE_EVENT:
+			apply = _spEventTimeline_apply;
+			dispose = _spEventTimeline_dispose;
+			setBezier = 0;
+			break;
+		case SP_TIMELINE_DRAWORDER:
+			apply = _spDrawOrderTimeline_apply;
+			dispose = _spDrawOrderTimeline_dispose;
+			setBezier = 0;
+			break;
+		case SP_TIMELINE_INHERIT:
+			apply = _spInheritTimeline_apply;
+			dispose = _spInheritTimeline_dispose;
+			setBezier = 0;
+			break;
+		case SP_TIMELINE_PHYSICSCONSTRAINT_RESET:
+			apply = _spPhysicsConstraintResetTimeline_apply;
+			dispose = _spPhysicsConstraintResetTimeline_dispose;
+			setBezier = 0;
+			break;
+		default:
+			return 0;
+	}
+
+	self->vtable.apply = apply;
+	self->vtable.dispose = dispose;
+	self->vtable.setBezier = setBezier;
+	return 1;
+}
@@ -38,7 +38,8 @@ THE SOFTWARE.
 #include <ctype.h>
 #include <spine/extension.h>
 #include <stdio.h>
-#include <stdlib.h> /* strtod (C89), strtof (C99) */
+#include <math.h>
+#include <stdlib.h>
 #include <string.h> /* strcasecmp (4.4BSD - compatibility), _stricmp (_WIN32) */
 
 #ifndef SPINE_JSON_DEBUG
@@ -46,7 +47,14 @@ THE SOFTWARE.
 #define SPINE_JSON_DEBUG 0
 #endif
 
-static const char *ep;
+/* Defold: skeletons may be parsed on more than one thread at once (see resource.create_spinescene_async) */
+#if defined(_MSC_VER)
+#define JSON_THREAD_LOCAL __declspec(thread)
+#else
+#define JSON_THREAD_LOCAL __thread
+#endif
+
+static JSON_THREAD_LOCAL const char *ep;
 
 const char *Json_getError(void) {
 	return ep;
@@ -71,76 +79,143 @@ static int Json_strcasecmp(const char *s1, const char *s2) {
 	}
 }
 
+/* Nodes and strings are bump allocated from blocks owned by the root, so a parse costs a handful of
+   allocations instead of one per node and string, and Json_dispose frees the whole tree at once. */
+#define JSON_ARENA_ALIGN 16
+#define JSON_ARENA_MIN_BLOCK_SIZE (16 * 1024)
+#define JSON_ARENA_MAX_BLOCK_SIZE (1024 * 1024)
+
+typedef struct _JsonArenaBlock {
+	struct _JsonArenaBlock *next;
+	size_t size;
+	size_t used;
+} _JsonArenaBlock;
+
+#define JSON_ARENA_HEADER_SIZE ((sizeof(_JsonArenaBlock) + JSON_ARENA_ALIGN - 1) & ~(size_t) (JSON_ARENA_ALIGN - 1))
+
+typedef struct _JsonArena {
+	_JsonArenaBlock *blocks;
+	size_t blockSize;
+} _JsonArena;
+
+/* The root node owns the arena. It must stay the first member. */
+typedef struct _JsonRoot {
+	Json json;
+	_JsonArena arena;
+} _JsonRoot;
+
+static void *_Json_alloc(_JsonArena *arena, size_t size) {
+	_JsonArenaBlock *block = arena->blocks;
+	char *ptr;
+	size = (size + JSON_ARENA_ALIGN - 1) & ~(size_t) (JSON_ARENA_ALIGN - 1);
+	if (!block || block->used + size > block->size) {
+		size_t blockSize = size > arena->blockSize ? size : arena->blockSize;
+		block = (_JsonArenaBlock *) MALLOC(char, JSON_ARENA_HEADER_SIZE + blockSize);
+		if (!block) return 0;
+		block->size = blockSize;
+		block->used = 0;
+		block->next = arena->blocks;
+		arena->blocks = block;
+	}
+	ptr = (char *) block + JSON_ARENA_HEADER_SIZE + block->used;
+	block->used += size;
+	return ptr;
+}
+
 /* Internal constructor. */
-static Json *Json_new(void) {
-	return (Json *) CALLOC(Json, 1);
+static Json *Json_new(_JsonArena *arena) {
+	Json *json = (Json *) _Json_alloc(arena, sizeof(Json));
+	if (json) memset(json, 0, sizeof(Json));
+	return json;
 }
 
-/* Delete a Json structure. */
+/* Delete a Json tree. Only the root returned by Json_create may be disposed. */
 void Json_dispose(Json *c) {
-	Json *next;
-	while (c) {
-		next = c->next;
-		if (c->child) Json_dispose(c->child);
-		if (c->valueString) FREE(c->valueString);
-		if (c->name) FREE(c->name);
-		FREE(c);
-		c = next;
+	_JsonRoot *root = (_JsonRoot *) c;
+	_JsonArenaBlock *block;
+	if (!root) return;
+	block = root->arena.blocks;
+	while (block) {
+		_JsonArenaBlock *next = block->next;
+		FREE(block);
+		block = next;
 	}
+	FREE(root);
 }
 
-/* Parse the input text to generate a number, and populate the result into item. */
+/* Exactly representable powers of ten, used for the fast path in parse_number. */
+static const double powersOf10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/* Parse the input text to generate a number, and populate the result into item.
+   The digits are gathered into an integer mantissa and a decimal exponent. When both are small enough
+   the value is a single exact multiply or divide, otherwise it falls back to pow(). */
 static const char *parse_number(Json *item, const char *num) {
-	double result = 0.0;
+	double result;
+	unsigned long long mantissa = 0;
+	int mantissaDigits = 0;
+	int exponent = 0;
 	int negative = 0;
-	char *ptr = (char *) num;
+	const char *ptr = num;
 
 	if (*ptr == '-') {
-		negative = -1;
+		negative = 1;
 		++ptr;
 	}
 
 	while (*ptr >= '0' && *ptr <= '9') {
-		result = result * 10.0 + (*ptr - '0');
+		if (mantissaDigits < 19) {
+			mantissa = mantissa * 10 + (unsigned) (*ptr - '0');
+			if (mantissa) ++mantissaDigits;
+		} else {
+			++exponent; /* Drop digits that don't fit, keep the magnitude. */
+		}
 		++ptr;
 	}
 
 	if (*ptr == '.') {
-		double fraction = 0.0;
-		int n = 0;
 		++ptr;
-
 		while (*ptr >= '0' && *ptr <= '9') {
-			fraction = (fraction * 10.0) + (*ptr - '0');
+			if (mantissaDigits < 19) {
+				mantissa = mantissa * 10 + (unsigned) (*ptr - '0');
+				if (mantissa) ++mantissaDigits;
+				--exponent;
+			}
 			++ptr;
-			++n;
 		}
-		result += fraction / POW(10.0, n);
 	}
-	if (negative) result = -result;
 
 	if (*ptr == 'e' || *ptr == 'E') {
-		double exponent = 0;
+		int explicitExponent = 0;
 		int expNegative = 0;
 		++ptr;
 
 		if (*ptr == '-') {
-			expNegative = -1;
+			expNegative = 1;
 			++ptr;
 		} else if (*ptr == '+') {
 			++ptr;
 		}
 
 		while (*ptr >= '0' && *ptr <= '9') {
-			exponent = (exponent * 10.0) + (*ptr - '0');
+			if (explicitExponent < 10000) explicitExponent = explicitExponent * 10 + (*ptr - '0');
 			++ptr;
 		}
+		exponent += expNegative ? -explicitExponent : explicitExponent;
+	}
 
-		if (expNegative)
-			result = result / POW(10, exponent);
-		else
-			result = result * POW(10, exponent);
+	result = (double) mantissa;
+	if (mantissa == 0 || exponent == 0) {
+		/* Integer or zero, nothing to scale. */
+	} else if (mantissa <= (1ULL << 53) && exponent > 0 && exponent <= 22) {
+		result *= powersOf10[exponent];
+	} else if (mantissa <= (1ULL << 53) && exponent < 0 && exponent >= -22) {
+		result /= powersOf10[-exponent];
+	} else {
+		result *= pow(10.0, exponent);
 	}
+	if (negative) result = -result;
 
 	if (ptr != num) {
 		/* Parse success, number found. */
@@ -158,7 +233,7 @@ static const char *parse_number(Json *item, const char *num) {
 /* Parse the input text into an unescaped cstring, and populate item. */
 static const unsigned char firstByteMark[7] = {0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};
 
-static const char *parse_string(Json *item, const char *str) {
+static const char *parse_string(_JsonArena *arena, Json *item, const char *str) {
 	const char *ptr = str + 1;
 	char *ptr2;
 	char *out;
@@ -172,7 +247,7 @@ static const char *parse_string(Json *item, const char *str) {
 	while (*ptr != '\"' && *ptr && ++len)
 		if (*ptr++ == '\\') ptr++; /* Skip escaped quotes. */
 
-	out = MALLOC(char, len + 1); /* The length needed for the string, roughly. */
+	out = (char *) _Json_alloc(arena, len + 1); /* The length needed for the string, roughly. */
 	if (!out) return 0;
 
 	ptr = str + 1;
@@ -256,11 +331,11 @@ static const char *parse_string(Json *item, const char *str) {
 }
 
 /* Predeclare these prototypes. */
-static const char *parse_value(Json *item, const char *value);
+static const char *parse_value(_JsonArena *arena, Json *item, const char *value);
 
-static const char *parse_array(Json *item, const char *value);
+static const char *parse_array(_JsonArena *arena, Json *item, const char *value);
 
-static const char *parse_object(Json *item, const char *value);
+static const char *parse_object(_JsonArena *arena, Json *item, const char *value);
 
 /* Utility to jump whitespace and cr/lf */
 static const char *skip(const char *in) {
@@ -272,23 +347,29 @@ static const char *skip(const char *in) {
 
 /* Parse an object - create a new root, and populate. */
 Json *Json_create(const char *value) {
-	Json *c;
+	_JsonRoot *root;
+	size_t length;
 	ep = 0;
 	if (!value) return 0; /* only place we check for NULL other than skip() */
-	c = Json_new();
-	if (!c) return 0; /* memory fail */
+	root = CALLOC(_JsonRoot, 1);
+	if (!root) return 0; /* memory fail */
 
-	value = parse_value(c, skip(value));
+	/* The tree takes roughly as many bytes as the text, so few blocks are needed. */
+	length = strlen(value);
+	length = length < JSON_ARENA_MIN_BLOCK_SIZE ? JSON_ARENA_MIN_BLOCK_SIZE : length;
+	root->arena.blockSize = length > JSON_ARENA_MAX_BLOCK_SIZE ? JSON_ARENA_MAX_BLOCK_SIZE : length;
+
+	value = parse_value(&root->arena, &root->json, skip(value));
 	if (!value) {
-		Json_dispose(c);
+		Json_dispose(&root->json);
 		return 0;
 	} /* parse failure. ep is set. */
 
-	return c;
+	return &root->json;
 }
 
 /* Parser core - when encountering text, process appropriately. */
-static const char *parse_value(Json *item, const char *value) {
+static const char *parse_value(_JsonArena *arena, Json *item, const char *value) {
 	/* Referenced by Json_create(), parse_array(), and parse_object(). */
 	/* Always called with the result of skip(). */
 #if SPINE_JSON_DEBUG      /* Checked at entry to graph, Json_create, and after every parse_ call. */
@@ -320,11 +401,11 @@ static const char *parse_value(Json *item, const char *value) {
 			break;
 		}
 		case '\"':
-			return parse_string(item, value);
+			return parse_string(arena, item, value);
 		case '[':
-			return parse_array(item, value);
+			return parse_array(arena, item, value);
 		case '{':
-			return parse_object(item, value);
+			return parse_object(arena, item, value);
 		case '-': /* fallthrough */
 		case '0': /* fallthrough */
 		case '1': /* fallthrough */
@@ -346,7 +427,7 @@ static const char *parse_value(Json *item, const char *value) {
 }
 
 /* Build an array from input text. */
-static const char *parse_array(Json *item, const char *value) {
+static const char *parse_array(_JsonArena *arena, Json *item, const char *value) {
 	Json *child;
 
 #if SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
@@ -360,21 +441,21 @@ static const char *parse_array(Json *item, const char *value) {
 	value = skip(value + 1);
 	if (*value == ']') return value + 1; /* empty array. */
 
-	item->child = child = Json_new();
+	item->child = child = Json_new(arena);
 	if (!item->child) return 0;                    /* memory fail */
-	value = skip(parse_value(child, skip(value))); /* skip any spacing, get the value. */
+	value = skip(parse_value(arena, child, skip(value))); /* skip any spacing, get the value. */
 	if (!value) return 0;
 	item->size = 1;
 
 	while (*value == ',') {
-		Json *new_item = Json_new();
+		Json *new_item = Json_new(arena);
 		if (!new_item) return 0; /* memory fail */
 		child->next = new_item;
 #if SPINE_JSON_HAVE_PREV
 		new_item->prev = child;
 #endif
 		child = new_item;
-		value = skip(parse_value(child, skip(value + 1)));
+		value = skip(parse_value(arena, child, skip(value + 1)));
 		if (!value) return 0; /* parse fail */
 		item->size++;
 	}
@@ -385,7 +466,7 @@ static const char *parse_array(Json *item, const char *value) {
 }
 
 /* Build an object from the text. */
-static const char *parse_object(Json *item, const char *value) {
+static const char *parse_object(_JsonArena *arena, Json *item, const char *value) {
 	Json *child;
 
 #if SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
@@ -399,9 +480,9 @@ static const char *parse_object(Json *item, const char *value) {
 	value = skip(value + 1);
 	if (*value == '}') return value + 1; /* empty array. */
 
-	item->child = child = Json_new();
+	item->child = child = Json_new(arena);
 	if (!item->child) return 0;
-	value = skip(parse_string(child, skip(value)));
+	value = skip(parse_string(arena, child, skip(value)));
 	if (!value) return 0;
 	child->name = child->valueString;
 	child->valueString = 0;
@@ -409,19 +490,19 @@ static const char *parse_object(Json *item, const char *value) {
 		ep = value;
 		return 0;
 	}                                                  /* fail! */
-	value = skip(parse_value(child, skip(value + 1))); /* skip any spacing, get the value. */
+	value = skip(parse_value(arena, child, skip(value + 1))); /* skip any spacing, get the value. */
 	if (!value) return 0;
 	item->size = 1;
 
 	while (*value == ',') {
-		Json *new_item = Json_new();
+		Json *new_item = Json_new(arena);
 		if (!new_item) return 0; /* memory fail */
 		child->next = new_item;
 #if SPINE_JSON_HAVE_PREV
 		new_item->prev = child;
 #endif
 		child = new_item;
-		value = skip(parse_string(child, skip(value + 1)));
+		value = skip(parse_string(arena, child, skip(value + 1)));
 		if (!value) return 0;
 		child->name = child->valueString;
 		child->valueString = 0;
@@ -429,7 +510,7 @@ static const char *parse_object(Json *item, const char *value) {
 			ep = value;
 			return 0;
 		}                                                  /* fail! */
-		value = skip(parse_value(child, skip(value + 1))); /* skip any spacing, get the value. */
+		value = skip(parse_value(arena, child, skip(value + 1))); /* skip any spacing, get the value. */
 		if (!value) return 0;
 		item->size++;
 	}
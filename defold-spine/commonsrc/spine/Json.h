@@ -64,7 +64,7 @@ typedef struct Json {
 /* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished. */
 Json *Json_create(const char *value);
 
-/* Delete a Json entity and all subentities. */
+/* Delete a Json tree. Only valid for the root returned by Json_create, the nodes are allocated from a block owned by it. */
 void Json_dispose(Json *json);
 
 /* Get item "string" from object. Case insensitive. */
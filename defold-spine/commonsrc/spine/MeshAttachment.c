@@ -104,8 +104,10 @@ void spMeshAttachment_updateRegion(spMeshAttachment *self) {
 	float *uvs;
 	float u, v, width, height;
 	int verticesLength = SUPER(self)->worldVerticesLength;
-	FREE(self->uvs);
-	uvs = self->uvs = MALLOC(float, verticesLength);
+	/* Defold: the vertex count doesn't change after loading, so an existing buffer is reused. Precompiled
+	 * skeletons (see dmSpine::LoadSkeletonBlob) keep it in memory that isn't owned by the attachment. */
+	if (!self->uvs) self->uvs = MALLOC(float, verticesLength);
+	uvs = self->uvs;
 	n = verticesLength;
 	u = self->region->u;
 	v = self->region->v;
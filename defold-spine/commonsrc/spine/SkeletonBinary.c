@@ -96,6 +96,7 @@ void spSkeletonBinary_dispose(spSkeletonBinary *self) {
 	_spSkeletonBinary *internal = SUB_CAST(_spSkeletonBinary, self);
 	if (internal->ownsLoader) spAttachmentLoader_dispose(self->attachmentLoader);
 	FREE(internal->linkedMeshes);
+	FREE(self->animationOffsets);
 	FREE(self->error);
 	FREE(self);
 }
@@ -996,6 +997,284 @@ static spAnimation *_spSkeletonBinary_readAnimation(spSkeletonBinary *self, cons
 	return animation;
 }
 
+/* Defold: skips the frames of a curve timeline, where each frame has valueBytes of values and a bezier has
+ * curveCount curves. Returns the time of the last frame. */
+static float _skipCurveFrames(_dataInput *input, int frameCount, int valueBytes, int curveCount) {
+	int frame;
+	float time = readFloat(input);
+	input->cursor += valueBytes;
+	for (frame = 1; frame < frameCount; ++frame) {
+		time = readFloat(input);
+		input->cursor += valueBytes;
+		if (readSByte(input) == CURVE_BEZIER) input->cursor += curveCount * 4 * sizeof(float);
+	}
+	return time;
+}
+
+/* Defold: walks an animation the same way as _spSkeletonBinary_readAnimation, without creating the timelines.
+ * Returns 0 on unknown timeline types, otherwise 1 and the duration of the animation. */
+static int _spSkeletonBinary_skipAnimation(_dataInput *input, spSkeletonData *skeletonData, float *outDuration) {
+	int i, n, ii, nn, iii, nnn, frame;
+	float duration = 0, time = 0;
+
+	readVarint(input, 1); /* numTimelines */
+
+	/* Slot timelines. */
+	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
+		readVarint(input, 1);
+		for (ii = 0, nn = readVarint(input, 1); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, 1);
+			time = 0;
+			switch (timelineType) {
+				case SLOT_ATTACHMENT:
+					for (frame = 0; frame < frameCount; ++frame) {
+						time = readFloat(input);
+						readVarint(input, 1);
+					}
+					break;
+				case SLOT_RGBA:
+					readVarint(input, 1);
+					time = _skipCurveFrames(input, frameCount, 4, 4);
+					break;
+				case SLOT_RGB:
+					readVarint(input, 1);
+					time = _skipCurveFrames(input, frameCount, 3, 3);
+					break;
+				case SLOT_RGBA2:
+					readVarint(input, 1);
+					time = _skipCurveFrames(input, frameCount, 7, 7);
+					break;
+				case SLOT_RGB2:
+					readVarint(input, 1);
+					time = _skipCurveFrames(input, frameCount, 6, 6);
+					break;
+				case SLOT_ALPHA:
+					readVarint(input, 1);
+					time = _skipCurveFrames(input, frameCount, 1, 1);
+					break;
+				default:
+					return 0;
+			}
+			duration = MAX(duration, time);
+		}
+	}
+
+	/* Bone timelines. */
+	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
+		readVarint(input, 1);
+		for (ii = 0, nn = readVarint(input, 1); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, 1);
+			time = 0;
+			if (timelineType == BONE_INHERIT) {
+				for (frame = 0; frame < frameCount; frame++) {
+					time = readFloat(input);
+					readByte(input);
+				}
+				duration = MAX(duration, time);
+				continue;
+			}
+			readVarint(input, 1);
+			switch (timelineType) {
+				case BONE_ROTATE:
+				case BONE_TRANSLATEX:
+				case BONE_TRANSLATEY:
+				case BONE_SCALEX:
+				case BONE_SCALEY:
+				case BONE_SHEARX:
+				case BONE_SHEARY:
+					time = _skipCurveFrames(input, frameCount, sizeof(float), 1);
+					break;
+				case BONE_TRANSLATE:
+				case BONE_SCALE:
+				case BONE_SHEAR:
+					time = _skipCurveFrames(input, frameCount, 2 * sizeof(float), 2);
+					break;
+				default:
+					return 0;
+			}
+			duration = MAX(duration, time);
+		}
+	}
+
+	/* IK constraint timelines. */
+	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
+		int frameCount, flags;
+		readVarint(input, 1);
+		frameCount = readVarint(input, 1);
+		readVarint(input, 1);
+		flags = readByte(input);
+		time = readFloat(input);
+		if ((flags & 1) != 0 && (flags & 2) != 0) readFloat(input);
+		if ((flags & 4) != 0) readFloat(input);
+		for (frame = 1; frame < frameCount; frame++) {
+			flags = readByte(input);
+			time = readFloat(input);
+			if ((flags & 1) != 0 && (flags & 2) != 0) readFloat(input);
+			if ((flags & 4) != 0) readFloat(input);
+			if ((flags & 64) == 0 && (flags & 128) != 0) input->cursor += 2 * 4 * sizeof(float);
+		}
+		duration = MAX(duration, time);
+	}
+
+	/* Transform constraint timelines. */
+	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
+		int frameCount;
+		readVarint(input, 1);
+		frameCount = readVarint(input, 1);
+		readVarint(input, 1);
+		time = _skipCurveFrames(input, frameCount, 6 * sizeof(float), 6);
+		duration = MAX(duration, time);
+	}
+
+	/* Path constraint timelines. */
+	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
+		readVarint(input, 1);
+		for (ii = 0, nn = readVarint(input, 1); ii < nn; ++ii) {
+			int type = readByte(input);
+			int frameCount = readVarint(input, 1);
+			readVarint(input, 1);
+			switch (type) {
+				case PATH_POSITION:
+				case PATH_SPACING:
+					time = _skipCurveFrames(input, frameCount, sizeof(float), 1);
+					duration = MAX(duration, time);
+					break;
+				case PATH_MIX:
+					time = _skipCurveFrames(input, frameCount, 3 * sizeof(float), 3);
+					duration = MAX(duration, time);
+					break;
+			}
+		}
+	}
+
+	/* Physics constraint timelines. */
+	for (i = 0, n = readVarint(input, 1); i < n; i++) {
+		readVarint(input, 1);
+		for (ii = 0, nn = readVarint(input, 1); ii < nn; ii++) {
+			int type = readByte(input);
+			int frameCount = readVarint(input, 1);
+			if (type == PHYSICS_RESET) {
+				time = 0;
+				for (frame = 0; frame < frameCount; frame++)
+					time = readFloat(input);
+				duration = MAX(duration, time);
+				continue;
+			}
+			readVarint(input, 1);
+			switch (type) {
+				case PHYSICS_INERTIA:
+				case PHYSICS_STRENGTH:
+				case PHYSICS_DAMPING:
+				case PHYSICS_MASS:
+				case PHYSICS_WIND:
+				case PHYSICS_GRAVITY:
+				case PHYSICS_MIX:
+					time = _skipCurveFrames(input, frameCount, sizeof(float), 1);
+					duration = MAX(duration, time);
+			}
+		}
+	}
+
+	/* Attachment timelines. */
+	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
+		readVarint(input, 1);
+		for (ii = 0, nn = readVarint(input, 1); ii < nn; ++ii) {
+			readVarint(input, 1);
+			for (iii = 0, nnn = readVarint(input, 1); iii < nnn; ++iii) {
+				unsigned int timelineType;
+				int frameCount;
+				time = 0;
+				readVarint(input, 1);
+				timelineType = readByte(input);
+				frameCount = readVarint(input, 1);
+				switch (timelineType) {
+					case ATTACHMENT_DEFORM:
+						readVarint(input, 1);
+						time = readFloat(input);
+						for (frame = 0;; ++frame) {
+							int end = readVarint(input, 1);
+							if (end) {
+								readVarint(input, 1);
+								input->cursor += end * sizeof(float);
+							}
+							if (frame == frameCount - 1) break;
+							time = readFloat(input);
+							if (readSByte(input) == CURVE_BEZIER) input->cursor += 4 * sizeof(float);
+						}
+						break;
+					case ATTACHMENT_SEQUENCE:
+						for (frame = 0; frame < frameCount; frame++) {
+							time = readFloat(input);
+							input->cursor += sizeof(int) + sizeof(float);
+						}
+						break;
+				}
+				duration = MAX(duration, time);
+			}
+		}
+	}
+
+	/* Draw order timeline. */
+	n = readVarint(input, 1);
+	for (i = 0; i < n; ++i) {
+		time = readFloat(input);
+		for (ii = 0, nn = readVarint(input, 1); ii < nn; ++ii) {
+			readVarint(input, 1);
+			readVarint(input, 1);
+		}
+		duration = MAX(duration, time);
+	}
+
+	/* Event timeline. */
+	n = readVarint(input, 1);
+	for (i = 0; i < n; ++i) {
+		time = readFloat(input);
+		spEventData *eventData = skeletonData->events[readVarint(input, 1)];
+		int length;
+		readVarint(input, 0);
+		readFloat(input);
+		length = readVarint(input, 1);
+		if (length > 0) input->cursor += length - 1;
+		if (eventData->audioPath) input->cursor += 2 * sizeof(float);
+		duration = MAX(duration, time);
+	}
+
+	*outDuration = duration;
+	return 1;
+}
+
+int spSkeletonBinary_readAnimationTimelines(spSkeletonBinary *self, const unsigned char *binary, const int length,
+											int offset, spSkeletonData *skeletonData, spAnimation *animation) {
+	spAnimation *decoded;
+	spTimelineArray *timelines;
+	spPropertyIdArray *timelineIds;
+	_dataInput input;
+	input.cursor = binary + offset;
+	input.end = binary + length;
+
+	FREE(self->error);
+	self->error = 0;
+
+	decoded = _spSkeletonBinary_readAnimation(self, animation->name, &input, skeletonData);
+	if (!decoded) {
+		if (!self->error) _spSkeletonBinary_setError(self, "Animation corrupted: ", animation->name);
+		return 0;
+	}
+
+	/* Other objects reference the animation, so we keep it and take the decoded timelines instead. */
+	timelines = animation->timelines;
+	timelineIds = animation->timelineIds;
+	animation->timelines = decoded->timelines;
+	animation->timelineIds = decoded->timelineIds;
+	animation->duration = decoded->duration;
+	decoded->timelines = timelines;
+	decoded->timelineIds = timelineIds;
+	spAnimation_dispose(decoded);
+	return 1;
+}
+
 static float *_readFloatArray(_dataInput *input, int n, float scale) {
 	float *array = MALLOC(float, n);
 	int i;
@@ -1651,11 +1930,23 @@ spSkeletonData *spSkeletonBinary_readSkeletonData(spSkeletonBinary *self, const
 	}
 
 	/* Animations. */
+	if (self->skipAnimations) {
+		FREE(input);
+		return skeletonData;
+	}
 	skeletonData->animationsCount = readVarint(input, 1);
 	skeletonData->animations = MALLOC(spAnimation *, skeletonData->animationsCount);
+	FREE(self->animationOffsets);
+	self->animationOffsets = self->lazyAnimations ? MALLOC(int, skeletonData->animationsCount) : 0;
 	for (i = 0; i < skeletonData->animationsCount; ++i) {
 		const char *name = readString(input);
-		spAnimation *animation = _spSkeletonBinary_readAnimation(self, name, input, skeletonData);
+		spAnimation *animation;
+		if (self->lazyAnimations) {
+			float duration;
+			self->animationOffsets[i] = (int) (input->cursor - binary);
+			animation = _spSkeletonBinary_skipAnimation(input, skeletonData, &duration) ? spAnimation_create(name, NULL, duration) : NULL;
+		} else
+			animation = _spSkeletonBinary_readAnimation(self, name, input, skeletonData);
 		if (!animation) {
 			_spSkeletonBinary_setError(self, "Animation corrupted: ", name);
 			FREE(name);
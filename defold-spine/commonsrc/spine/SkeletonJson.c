@@ -1782,7 +1782,7 @@ spSkeletonData *spSkeletonJson_readSkeletonData(spSkeletonJson *self, const char
 	}
 
 	/* Animations. */
-	animations = Json_getItem(root, "animations");
+	animations = self->skipAnimations ? 0 : Json_getItem(root, "animations");
 	if (animations) {
 		Json *animationMap;
 		skeletonData->animations = MALLOC(spAnimation *, animations->size);
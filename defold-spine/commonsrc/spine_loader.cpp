@@ -5,6 +5,10 @@ extern "C" {
 #include <spine/Attachment.h>
 #include <spine/SkeletonBinary.h>
 #include <spine/SkeletonJson.h>
+#include <spine/SkeletonData.h>
+#include <spine/Animation.h>
+#include <spine/VertexAttachment.h>
+#include <spine/Skin.h>
 }
 
 #include <limits.h>
@@ -12,6 +16,7 @@ extern "C" {
 
 #include <dmsdk/dlib/hash.h>
 #include <dmsdk/dlib/log.h>
+#include <dmsdk/dlib/time.h>
 #include <dmsdk/gamesys/resources/res_textureset.h>
 
 #include <common/spine_loader.h>
@@ -99,6 +104,8 @@ namespace dmSpine
     static spAtlasRegion* CreateRegionsFromQuads(dmGameSystemDDF::TextureSet* texture_set_ddf)
     {
         const float* tex_coords = (const float*) texture_set_ddf->m_TexCoords.m_Data;
+        const uint32_t* page_indices = texture_set_ddf->m_PageIndices.m_Data;
+        uint32_t n_page_indices = texture_set_ddf->m_PageIndices.m_Count;
         uint32_t n_animations = texture_set_ddf->m_Animations.m_Count;
         dmGameSystemDDF::TextureSetAnimation* animations = texture_set_ddf->m_Animations.m_Data;
 
@@ -192,6 +199,12 @@ namespace dmSpine
                 region->offsetY = 0;
                 region->width = region->originalWidth = animation_ddf->m_Width;
                 region->height = region->originalHeight = animation_ddf->m_Height;
+
+                // Multi page atlases are a single texture array, so each region only needs to know its layer.
+                // We resolve sequences by name, so the spine atlas 'index' field is free to hold the page index.
+                atlasRegion->index = frame_index < n_page_indices ? (int)page_indices[frame_index] : 0;
+
+                DEBUGLOG("  page: %d", atlasRegion->index);
         }
 
         return regions;
@@ -213,41 +226,106 @@ namespace dmSpine
         return &regions[*anim_index];
     }
 
-    static bool loadSequence(dmHashTable64<uint32_t>* name_to_index, spAtlasRegion* atlasRegions, const char *basePath, spSequence *sequence, spAtlasRegion* default_region) {
-        bool is_atlas_available = name_to_index != 0;
+    // Writes the frame number as spSequence_getPath() does, zero padded to 'digits'
+    static uint32_t FormatSequenceNumber(uint32_t value, int digits, char* out)
+    {
+        char tmp[16];
+        uint32_t count = 0;
+        do {
+            tmp[count++] = '0' + (value % 10);
+            value /= 10;
+        } while (value != 0);
+
+        uint32_t length = 0;
+        for (int i = (int)count; i < digits; ++i)
+            out[length++] = '0';
+        while (count > 0)
+            out[length++] = tmp[--count];
+        return length;
+    }
 
-        // The C runtime seems a bit broken,
-        // and doesn't account for number of digits required regions->size
-        // So, instead, we simply add some extra room for X digits
-        uint32_t region_digits = 8;
+    // Resolves all frames of a sequence. The base path is only hashed once,
+    // and each frame only adds its number to a copy of that hash state.
+    static bool loadSequence(spDefoldAtlasAttachmentLoader* self, const char *basePath, spSequence *sequence) {
         spTextureRegionArray *regions = sequence->regions;
-        char *path = (char*)MALLOC(char, strlen(basePath) + sequence->digits + region_digits + 1);
-        path[0] = 0;
-        int i;
-        for (i = 0; i < regions->size; i++) {
-            spSequence_getPath(sequence, basePath, i, path);
-            regions->items[i] = is_atlas_available ? SUPER(FindAtlasRegion(name_to_index, atlasRegions, path)) : SUPER(default_region);
-            if (!regions->items[i]) {
+        self->profile.m_SequenceFrameCount += regions->size;
+
+        if (!self->name_to_index) {
+            for (int i = 0; i < regions->size; i++) {
+                regions->items[i] = SUPER(self->default_region);
+                regions->items[i]->rendererObject = regions->items[i];
+            }
+            return true;
+        }
+
+        HashState64 base_state;
+        dmHashInit64(&base_state, false);
+        dmHashUpdateBuffer64(&base_state, basePath, strlen(basePath));
+
+        // Leaves room for any padding the sequence asks for
+        char number[64];
+        int digits = sequence->digits < 32 ? sequence->digits : 32;
+        for (int i = 0; i < regions->size; i++) {
+            int frame = sequence->start + i;
+            dmhash_t name_hash;
+            if (frame >= 0)
+            {
+                HashState64 state = base_state;
+                uint32_t length = FormatSequenceNumber((uint32_t)frame, digits, number);
+                dmHashUpdateBuffer64(&state, number, length);
+                name_hash = dmHashFinal64(&state);
+            }
+            else
+            {
+                // Not expected from the editor, but keep the exact runtime naming
+                char* path = (char*)MALLOC(char, strlen(basePath) + sequence->digits + 16);
+                spSequence_getPath(sequence, basePath, i, path);
+                name_hash = dmHashString64(path);
                 FREE(path);
-                return false;
             }
+
+            uint32_t* index = self->name_to_index->Get(name_hash);
+            if (!index)
+                return false;
+            regions->items[i] = SUPER((&self->regions[*index]));
             regions->items[i]->rendererObject = regions->items[i];
         }
-        FREE(path);
         return true;
     }
 
+    static bool LoadSequenceTimed(spDefoldAtlasAttachmentLoader* self, const char* path, spSequence* sequence)
+    {
+        uint64_t start = dmTime::GetMonotonicTime();
+        bool result = loadSequence(self, path, sequence);
+        self->profile.m_Sequences += dmTime::GetMonotonicTime() - start;
+        return result;
+    }
+
+    static spAttachment* CreateAttachment(spDefoldAtlasAttachmentLoader* self, spAttachmentLoader* loader, spAttachmentType type,
+        const char* name, const char* path, spSequence *sequence);
+
     static spAttachment* spDefoldAtlasAttachmentLoader_createAttachment(spAttachmentLoader* loader, spSkin* skin, spAttachmentType type,
         const char* name, const char* path, spSequence *sequence)
     {
+        UNUSED(skin);
         spDefoldAtlasAttachmentLoader* self = SUB_CAST(spDefoldAtlasAttachmentLoader, loader);
+        uint64_t start = dmTime::GetMonotonicTime();
+        spAttachment* attachment = CreateAttachment(self, loader, type, name, path, sequence);
+        self->profile.m_Attachments += dmTime::GetMonotonicTime() - start;
+        self->profile.m_AttachmentCount++;
+        return attachment;
+    }
+
+    static spAttachment* CreateAttachment(spDefoldAtlasAttachmentLoader* self, spAttachmentLoader* loader, spAttachmentType type,
+        const char* name, const char* path, spSequence *sequence)
+    {
         bool is_atlas_available = self->name_to_index != 0;
 
         switch (type) {
             case SP_ATTACHMENT_REGION: {
                 spRegionAttachment* attachment = spRegionAttachment_create(name);
                 if (sequence) {
-                    if (!loadSequence(self->name_to_index, self->regions, path, sequence, self->default_region)) {
+                    if (!LoadSequenceTimed(self, path, sequence)) {
                         spAttachment_dispose(SUPER(attachment));
                         _spAttachmentLoader_setError(loader, "Couldn't load sequence for region attachment: ", path);
                         return 0;
@@ -275,7 +353,7 @@ namespace dmSpine
             case SP_ATTACHMENT_LINKED_MESH: {
                 spMeshAttachment* attachment = spMeshAttachment_create(name);
                 if (sequence) {
-                    if (!loadSequence(self->name_to_index, self->regions, path, sequence, self->default_region)) {
+                    if (!LoadSequenceTimed(self, path, sequence)) {
                         spAttachment_dispose(SUPER(SUPER(attachment)));
                         _spAttachmentLoader_setError(loader, "Couldn't load sequence for mesh attachment: ", path);
                         return 0;
@@ -310,15 +388,37 @@ namespace dmSpine
                 _spAttachmentLoader_setUnknownTypeError(loader, type);
                 return 0;
         }
-
-        UNUSED(skin);
     }
 
-    spDefoldAtlasAttachmentLoader* CreateAttachmentLoader(dmGameSystemDDF::TextureSet* texture_set_ddf, spAtlasRegion* regions)
+    dmhash_t HashRegions(dmGameSystemDDF::TextureSet* texture_set_ddf)
     {
-        spDefoldAtlasAttachmentLoader* self = NEW(spDefoldAtlasAttachmentLoader);
-        _spAttachmentLoader_init(SUPER(self), _spAttachmentLoader_deinit, spDefoldAtlasAttachmentLoader_createAttachment, 0, 0);
+        const float* tex_coords = (const float*) texture_set_ddf->m_TexCoords.m_Data;
+        uint32_t n_tex_coords = texture_set_ddf->m_TexCoords.m_Count / (4 * 2 * sizeof(float));
+        const uint32_t* page_indices = texture_set_ddf->m_PageIndices.m_Data;
+        uint32_t n_page_indices = texture_set_ddf->m_PageIndices.m_Count;
+        uint32_t n_animations = texture_set_ddf->m_Animations.m_Count;
 
+        // Only what CreateRegions() and CreateRegionNameToIndex() read
+        HashState64 state;
+        dmHashInit64(&state, false);
+        dmHashUpdateBuffer64(&state, &n_animations, sizeof(n_animations));
+        for (uint32_t i = 0; i < n_animations; ++i)
+        {
+            const dmGameSystemDDF::TextureSetAnimation& animation_ddf = texture_set_ddf->m_Animations[i];
+            uint32_t frame_index = animation_ddf.m_Start;
+            uint32_t page_index = frame_index < n_page_indices ? page_indices[frame_index] : 0;
+            dmHashUpdateBuffer64(&state, animation_ddf.m_Id, strlen(animation_ddf.m_Id));
+            dmHashUpdateBuffer64(&state, &animation_ddf.m_Width, sizeof(animation_ddf.m_Width));
+            dmHashUpdateBuffer64(&state, &animation_ddf.m_Height, sizeof(animation_ddf.m_Height));
+            dmHashUpdateBuffer64(&state, &page_index, sizeof(page_index));
+            if (frame_index < n_tex_coords)
+                dmHashUpdateBuffer64(&state, &tex_coords[frame_index * 4 * 2], 4 * 2 * sizeof(float));
+        }
+        return dmHashFinal64(&state);
+    }
+
+    dmHashTable64<uint32_t>* CreateRegionNameToIndex(dmGameSystemDDF::TextureSet* texture_set_ddf)
+    {
         uint32_t n_animations = texture_set_ddf->m_Animations.m_Count;
         dmHashTable64<uint32_t>* name_to_index = new dmHashTable64<uint32_t>;
         name_to_index->SetCapacity(n_animations/2+1, n_animations);
@@ -327,11 +427,28 @@ namespace dmSpine
             dmhash_t h = dmHashString64(texture_set_ddf->m_Animations[i].m_Id);
             name_to_index->Put(h, i);
         }
+        return name_to_index;
+    }
+
+    spDefoldAtlasAttachmentLoader* CreateAttachmentLoader(dmGameSystemDDF::TextureSet* texture_set_ddf, spAtlasRegion* regions)
+    {
+        spDefoldAtlasAttachmentLoader* self = CreateAttachmentLoader(regions, CreateRegionNameToIndex(texture_set_ddf));
+        self->owns_name_to_index = true;
+        self->texture_set_ddf = texture_set_ddf;
+        return self;
+    }
+
+    spDefoldAtlasAttachmentLoader* CreateAttachmentLoader(spAtlasRegion* regions, dmHashTable64<uint32_t>* name_to_index)
+    {
+        spDefoldAtlasAttachmentLoader* self = NEW(spDefoldAtlasAttachmentLoader);
+        _spAttachmentLoader_init(SUPER(self), _spAttachmentLoader_deinit, spDefoldAtlasAttachmentLoader_createAttachment, 0, 0);
 
         self->name_to_index = name_to_index;
+        self->owns_name_to_index = false;
         self->default_region = 0;
-        self->texture_set_ddf = texture_set_ddf;
+        self->texture_set_ddf = 0;
         self->regions = regions;
+        memset(&self->profile, 0, sizeof(self->profile));
 
         return self;
     }
@@ -342,6 +459,7 @@ namespace dmSpine
         _spAttachmentLoader_init(SUPER(self), _spAttachmentLoader_deinit, spDefoldAtlasAttachmentLoader_createAttachment, 0, 0);
 
         self->name_to_index = 0;
+        self->owns_name_to_index = false;
         self->default_region = spAtlasRegion_create();
         self->default_region->super.u = 0;
         self->default_region->super.v = 0;
@@ -353,12 +471,14 @@ namespace dmSpine
         self->default_region->super.originalHeight = 1;
         self->texture_set_ddf = 0;
         self->regions = 0;
+        memset(&self->profile, 0, sizeof(self->profile));
         return self;
     }
 
     void Dispose(spDefoldAtlasAttachmentLoader* loader)
     {
-        delete loader->name_to_index;
+        if (loader->owns_name_to_index)
+            delete loader->name_to_index;
         if (loader->default_region)
             spAtlasRegion_dispose(loader->default_region);
         spAttachmentLoader_dispose((spAttachmentLoader*)loader);
@@ -372,6 +492,11 @@ namespace dmSpine
         return path_extension && strcmp(path_extension, extension) == 0;
     }
 
+    bool IsBinarySkeletonPath(const char* path)
+    {
+        return HasExtension(path, ".skel") || HasExtension(path, ".skelc");
+    }
+
     static void SetLoaderError(spAttachmentLoader* loader, const char* error)
     {
         FREE(loader->error1);
@@ -381,13 +506,14 @@ namespace dmSpine
         MALLOC_STR(loader->error1, error ? error : "unknown error");
     }
 
-    spSkeletonData* ReadSkeletonJsonData(spAttachmentLoader* loader, const char* path, void* json_data)
+    spSkeletonData* ReadSkeletonJsonData(spAttachmentLoader* loader, const char* path, void* json_data, ReadAnimationsMode mode)
     {
         spSkeletonJson* skeleton_json = spSkeletonJson_createWithLoader(loader);
         if (!skeleton_json) {
             dmLogError("Failed to create spine skeleton for %s", path);
             return 0;
         }
+        skeleton_json->skipAnimations = mode == READ_ANIMATIONS_NONE ? 1 : 0;
 
         //DEBUGLOG("%s: %p   json: %p", __FUNCTION__, skeleton_json, json_data);
 
@@ -403,7 +529,8 @@ namespace dmSpine
         return skeletonData;
     }
 
-    static spSkeletonData* ReadSkeletonBinaryData(spAttachmentLoader* loader, const char* path, const void* binary_data, size_t binary_data_size)
+    static spSkeletonData* ReadSkeletonBinaryData(spAttachmentLoader* loader, const char* path, const void* binary_data, size_t binary_data_size,
+                                                    ReadAnimationsMode mode, dmArray<uint32_t>* animation_offsets)
     {
         if (!binary_data || binary_data_size < 9)
         {
@@ -424,6 +551,8 @@ namespace dmSpine
             dmLogError("Failed to create spine skeleton for %s", path);
             return 0;
         }
+        skeleton_binary->skipAnimations = mode == READ_ANIMATIONS_NONE ? 1 : 0;
+        skeleton_binary->lazyAnimations = mode == READ_ANIMATIONS_LAZY ? 1 : 0;
 
         spSkeletonData* skeleton_data = spSkeletonBinary_readSkeletonData(skeleton_binary, (const unsigned char*)binary_data, (int)binary_data_size);
         if (!skeleton_data)
@@ -433,19 +562,351 @@ namespace dmSpine
             dmLogError("Failed to read spine skeleton for %s: %s", path, loader->error1);
             return 0;
         }
+        if (animation_offsets && skeleton_binary->animationOffsets)
+        {
+            uint32_t count = (uint32_t)skeleton_data->animationsCount;
+            animation_offsets->SetCapacity(count);
+            animation_offsets->SetSize(count);
+            for (uint32_t i = 0; i < count; ++i)
+                (*animation_offsets)[i] = (uint32_t)skeleton_binary->animationOffsets[i];
+        }
         spSkeletonBinary_dispose(skeleton_binary);
         return skeleton_data;
     }
 
-    spSkeletonData* ReadSkeletonData(spAttachmentLoader* loader, const char* path, const void* data, size_t data_size)
+    bool ReadAnimationTimelines(spAttachmentLoader* loader, const char* path, spSkeletonData* skeleton_data, const void* data, size_t data_size,
+                                uint32_t offset, spAnimation* animation)
+    {
+        spSkeletonBinary* skeleton_binary = spSkeletonBinary_createWithLoader(loader);
+        if (!skeleton_binary)
+            return false;
+
+        int ok = spSkeletonBinary_readAnimationTimelines(skeleton_binary, (const unsigned char*)data, (int)data_size, (int)offset, skeleton_data, animation);
+        if (!ok)
+        {
+            dmLogError("Failed to read spine animation '%s' for %s: %s", animation->name, path, skeleton_binary->error);
+        }
+        spSkeletonBinary_dispose(skeleton_binary);
+        return ok != 0;
+    }
+
+    spSkeletonData* ReadSkeletonData(spAttachmentLoader* loader, const char* path, const void* data, size_t data_size,
+                                        ReadAnimationsMode mode, dmArray<uint32_t>* animation_offsets)
     {
         FREE(loader->error1);
         FREE(loader->error2);
         loader->error1 = 0;
         loader->error2 = 0;
-        if (HasExtension(path, ".skel") || HasExtension(path, ".skelc"))
-            return ReadSkeletonBinaryData(loader, path, data, data_size);
-        return ReadSkeletonJsonData(loader, path, (void*)data);
+
+        SkeletonLoadProfile* profile = &SUB_CAST(spDefoldAtlasAttachmentLoader, loader)->profile;
+        memset(profile, 0, sizeof(*profile));
+        uint64_t start = dmTime::GetMonotonicTime();
+
+        spSkeletonData* skeleton_data;
+        if (IsBinarySkeletonPath(path))
+            skeleton_data = ReadSkeletonBinaryData(loader, path, data, data_size, mode, animation_offsets);
+        else
+            skeleton_data = ReadSkeletonJsonData(loader, path, (void*)data, mode == READ_ANIMATIONS_LAZY ? READ_ANIMATIONS_ALL : mode);
+
+        profile->m_Total = dmTime::GetMonotonicTime() - start;
+        if (skeleton_data)
+        {
+            dmLogDebug("Read '%s' in %.2f ms: attachments %.2f ms (%u attachments, sequence frames %.2f ms for %u frames)", path,
+                        profile->m_Total / 1000.0, profile->m_Attachments / 1000.0, profile->m_AttachmentCount,
+                        profile->m_Sequences / 1000.0, profile->m_SequenceFrameCount);
+        }
+        return skeleton_data;
+    }
+
+    bool CanShareAnimations(spSkeletonData* skeleton_data)
+    {
+        // Deform and mesh sequence timelines are matched through spVertexAttachment::timelineAttachment,
+        // which we can point at the owner's attachments. Region attachments have no such indirection.
+        for (int a = 0; a < skeleton_data->animationsCount; ++a)
+        {
+            spTimelineArray* timelines = skeleton_data->animations[a]->timelines;
+            for (int t = 0; t < timelines->size; ++t)
+            {
+                spTimeline* timeline = timelines->items[t];
+                if (timeline->type != SP_TIMELINE_SEQUENCE)
+                    continue;
+                if (((spSequenceTimeline*)timeline)->attachment->type == SP_ATTACHMENT_REGION)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    void BorrowAnimations(spSkeletonData* skeleton_data, spSkeletonData* owner)
+    {
+        skeleton_data->animations = owner->animations;
+        skeleton_data->animationsCount = owner->animationsCount;
+
+        // The skeletons are read from the same file, so the skins and their entries match 1:1
+        for (int s = 0; s < skeleton_data->skinsCount && s < owner->skinsCount; ++s)
+        {
+            spSkin* owner_skin = owner->skins[s];
+            spSkinEntry* entry = spSkin_getAttachments(skeleton_data->skins[s]);
+            for (; entry; entry = entry->next)
+            {
+                spAttachment* attachment = entry->attachment;
+                switch (attachment->type)
+                {
+                case SP_ATTACHMENT_BOUNDING_BOX:
+                case SP_ATTACHMENT_CLIPPING:
+                case SP_ATTACHMENT_MESH:
+                case SP_ATTACHMENT_PATH:
+                    break;
+                default:
+                    continue;
+                }
+                spAttachment* owner_attachment = spSkin_getAttachment(owner_skin, entry->slotIndex, entry->name);
+                if (!owner_attachment || owner_attachment->type != attachment->type)
+                    continue;
+                ((spVertexAttachment*)attachment)->timelineAttachment = ((spVertexAttachment*)owner_attachment)->timelineAttachment;
+            }
+        }
+    }
+
+    void ReturnAnimations(spSkeletonData* skeleton_data)
+    {
+        skeleton_data->animations = 0;
+        skeleton_data->animationsCount = 0;
+    }
+
+    uint64_t GetSkeletonBlobLayoutHash()
+    {
+        const uint32_t layout[] = {
+            SKELETON_BLOB_VERSION,
+            (uint32_t)sizeof(void*),
+            SKIN_ENTRIES_HASH_TABLE_SIZE,
+            (uint32_t)sizeof(spSkeletonData),
+            (uint32_t)sizeof(spBoneData),
+            (uint32_t)sizeof(spSlotData),
+            (uint32_t)sizeof(spEventData),
+            (uint32_t)sizeof(spEvent),
+            (uint32_t)sizeof(spIkConstraintData),
+            (uint32_t)sizeof(spTransformConstraintData),
+            (uint32_t)sizeof(spPathConstraintData),
+            (uint32_t)sizeof(spPhysicsConstraintData),
+            (uint32_t)sizeof(_spSkin),
+            (uint32_t)sizeof(_Entry),
+            (uint32_t)sizeof(_SkinHashTableEntry),
+            (uint32_t)sizeof(spAnimation),
+            (uint32_t)sizeof(spCurveTimeline),
+            (uint32_t)sizeof(spAttachmentTimeline),
+            (uint32_t)sizeof(spDeformTimeline),
+            (uint32_t)sizeof(spSequenceTimeline),
+            (uint32_t)sizeof(spEventTimeline),
+            (uint32_t)sizeof(spDrawOrderTimeline),
+            (uint32_t)sizeof(spFloatArray),
+            (uint32_t)sizeof(spRegionAttachment),
+            (uint32_t)sizeof(spMeshAttachment),
+            (uint32_t)sizeof(spBoundingBoxAttachment),
+            (uint32_t)sizeof(spPathAttachment),
+            (uint32_t)sizeof(spPointAttachment),
+            (uint32_t)sizeof(spClippingAttachment),
+            (uint32_t)sizeof(spSequence),
+            (uint32_t)sizeof(spAtlasRegion),
+        };
+        return dmHashBuffer64(layout, sizeof(layout));
+    }
+
+    // The attachment vtables are allocated per attachment, so we keep one attachment of each type alive
+    // for the lifetime of the process, and let the precompiled attachments point to its vtable.
+    // Those attachments are never disposed, since the blob holds a reference to each of them.
+    struct AttachmentVtables
+    {
+        const void* m_Vtables[SP_ATTACHMENT_CLIPPING + 1];
+
+        AttachmentVtables()
+        {
+            m_Vtables[SP_ATTACHMENT_REGION] = SUPER(spRegionAttachment_create(""))->vtable;
+            m_Vtables[SP_ATTACHMENT_BOUNDING_BOX] = SUPER(SUPER(spBoundingBoxAttachment_create("")))->vtable;
+            m_Vtables[SP_ATTACHMENT_MESH] = SUPER(SUPER(spMeshAttachment_create("")))->vtable;
+            m_Vtables[SP_ATTACHMENT_LINKED_MESH] = m_Vtables[SP_ATTACHMENT_MESH];
+            m_Vtables[SP_ATTACHMENT_PATH] = SUPER(SUPER(spPathAttachment_create("")))->vtable;
+            m_Vtables[SP_ATTACHMENT_POINT] = SUPER(spPointAttachment_create(""))->vtable;
+            m_Vtables[SP_ATTACHMENT_CLIPPING] = SUPER(SUPER(spClippingAttachment_create("")))->vtable;
+        }
+    };
+
+    static const AttachmentVtables& GetAttachmentVtables()
+    {
+        static AttachmentVtables vtables;
+        return vtables;
+    }
+
+    static bool IsValidTable(const SkeletonBlobHeader* header, uint32_t offset, uint32_t count)
+    {
+        return (offset & 3) == 0 && offset >= sizeof(SkeletonBlobHeader) && offset <= header->m_Size
+                && count <= (header->m_Size - offset) / sizeof(uint32_t);
+    }
+
+    static bool IsValidObjects(const SkeletonBlobHeader* header, const uint32_t* offsets, uint32_t count, uint32_t object_size, uint32_t alignment)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t offset = offsets[i];
+            if ((offset & (alignment - 1)) != 0 || offset < sizeof(SkeletonBlobHeader) || offset > header->m_Size - object_size)
+                return false;
+        }
+        return true;
+    }
+
+    // The pointers are still offsets into the blob, so they're checked the same way
+    static bool IsValidRelocations(const SkeletonBlobHeader* header, const uint32_t* relocations, uint32_t count)
+    {
+        const uint8_t* base = (const uint8_t*)header;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uintptr_t offset = *(const uintptr_t*)(base + relocations[i]);
+            if (offset != 0 && (offset < sizeof(SkeletonBlobHeader) || offset >= header->m_Size))
+                return false;
+        }
+        return true;
+    }
+
+    static bool IsValidAttachmentTypes(const SkeletonBlobHeader* header, const uint32_t* attachments, uint32_t count)
+    {
+        const uint8_t* base = (const uint8_t*)header;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const spAttachment* attachment = (const spAttachment*)(base + attachments[i]);
+            if ((uint32_t)attachment->type > SP_ATTACHMENT_CLIPPING)
+                return false;
+        }
+        return true;
+    }
+
+    static bool IsValidTimelineTypes(const SkeletonBlobHeader* header, const uint32_t* timelines, uint32_t count)
+    {
+        const uint8_t* base = (const uint8_t*)header;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            // Restored on a copy, since nothing may be changed before the whole blob is validated
+            spTimeline timeline = *(const spTimeline*)(base + timelines[i]);
+            if (!_spTimeline_restoreVtable(&timeline))
+                return false;
+        }
+        return true;
+    }
+
+    // Everything is validated before the blob is changed, so an invalid blob is left as it was
+    static bool IsValidSkeletonBlob(const void* blob, uint32_t blob_size)
+    {
+        const SkeletonBlobHeader* header = (const SkeletonBlobHeader*)blob;
+        if (!blob || ((uintptr_t)blob & 7) != 0 || blob_size < sizeof(SkeletonBlobHeader))
+            return false;
+        if (header->m_Magic != SKELETON_BLOB_MAGIC || header->m_Version != SKELETON_BLOB_VERSION || header->m_Loaded)
+            return false;
+        if (header->m_Size != blob_size || header->m_LayoutHash != GetSkeletonBlobLayoutHash())
+            return false;
+        if (!IsValidTable(header, header->m_Relocations, header->m_RelocationCount)
+            || !IsValidTable(header, header->m_Attachments, header->m_AttachmentCount)
+            || !IsValidTable(header, header->m_Timelines, header->m_TimelineCount))
+            return false;
+
+        const uint8_t* base = (const uint8_t*)blob;
+        const uint32_t* relocations = (const uint32_t*)(base + header->m_Relocations);
+        const uint32_t* attachments = (const uint32_t*)(base + header->m_Attachments);
+        const uint32_t* timelines = (const uint32_t*)(base + header->m_Timelines);
+        return IsValidObjects(header, relocations, header->m_RelocationCount, sizeof(uintptr_t), sizeof(uintptr_t))
+            && IsValidObjects(header, attachments, header->m_AttachmentCount, sizeof(spAttachment), sizeof(void*))
+            && IsValidObjects(header, timelines, header->m_TimelineCount, sizeof(spTimeline), sizeof(void*))
+            && IsValidObjects(header, &header->m_SkeletonData, 1, sizeof(spSkeletonData), sizeof(void*))
+            && IsValidRelocations(header, relocations, header->m_RelocationCount)
+            && IsValidAttachmentTypes(header, attachments, header->m_AttachmentCount)
+            && IsValidTimelineTypes(header, timelines, header->m_TimelineCount);
+    }
+
+    // Copies a skin from the blob. spSkin_setAttachment() prepends the entries, so they're added in reverse to keep the order.
+    static spSkin* CreateSkinFromBlob(const spSkin* blob_skin, dmArray<spSkinEntry*>& entries)
+    {
+        spSkin* skin = spSkin_create(blob_skin->name);
+        spBoneDataArray_addAll(skin->bones, blob_skin->bones);
+        spIkConstraintDataArray_addAll(skin->ikConstraints, blob_skin->ikConstraints);
+        spTransformConstraintDataArray_addAll(skin->transformConstraints, blob_skin->transformConstraints);
+        spPathConstraintDataArray_addAll(skin->pathConstraints, blob_skin->pathConstraints);
+        spPhysicsConstraintDataArray_addAll(skin->physicsConstraints, blob_skin->physicsConstraints);
+        skin->color = blob_skin->color;
+
+        entries.SetSize(0);
+        for (spSkinEntry* entry = spSkin_getAttachments(blob_skin); entry; entry = entry->next)
+        {
+            if (entries.Full())
+                entries.OffsetCapacity(entries.Capacity() + 64);
+            entries.Push(entry);
+        }
+        for (uint32_t i = entries.Size(); i > 0; --i)
+        {
+            spSkinEntry* entry = entries[i - 1];
+            spSkin_setAttachment(skin, entry->slotIndex, entry->name, entry->attachment);
+        }
+        return skin;
+    }
+
+    spSkeletonData* LoadSkeletonBlob(void* blob, uint32_t blob_size, dmhash_t regions_hash)
+    {
+        if (!IsValidSkeletonBlob(blob, blob_size))
+            return 0;
+
+        SkeletonBlobHeader* header = (SkeletonBlobHeader*)blob;
+        if (header->m_RegionsHash != regions_hash)
+            return 0;
+        header->m_Loaded = 1;
+
+        uint8_t* base = (uint8_t*)blob;
+        const uint32_t* relocations = (const uint32_t*)(base + header->m_Relocations);
+        for (uint32_t i = 0; i < header->m_RelocationCount; ++i)
+        {
+            uintptr_t* pointer = (uintptr_t*)(base + relocations[i]);
+            if (*pointer)
+                *pointer += (uintptr_t)base;
+        }
+
+        const AttachmentVtables& vtables = GetAttachmentVtables();
+        const uint32_t* attachments = (const uint32_t*)(base + header->m_Attachments);
+        for (uint32_t i = 0; i < header->m_AttachmentCount; ++i)
+        {
+            spAttachment* attachment = (spAttachment*)(base + attachments[i]);
+            attachment->vtable = vtables.m_Vtables[attachment->type];
+            attachment->refCount = 1; // Held by the blob, so it's never disposed
+        }
+
+        const uint32_t* timelines = (const uint32_t*)(base + header->m_Timelines);
+        for (uint32_t i = 0; i < header->m_TimelineCount; ++i)
+            _spTimeline_restoreVtable((spTimeline*)(base + timelines[i]));
+
+        spSkeletonData* skeleton_data = (spSkeletonData*)(base + header->m_SkeletonData);
+        dmArray<spSkinEntry*> entries;
+        spSkin* default_skin = 0;
+        for (int i = 0; i < skeleton_data->skinsCount; ++i)
+        {
+            spSkin* blob_skin = skeleton_data->skins[i];
+            skeleton_data->skins[i] = CreateSkinFromBlob(blob_skin, entries);
+            if (blob_skin == skeleton_data->defaultSkin)
+                default_skin = skeleton_data->skins[i];
+        }
+        if (skeleton_data->defaultSkin && !default_skin)
+            default_skin = CreateSkinFromBlob(skeleton_data->defaultSkin, entries);
+        skeleton_data->defaultSkin = default_skin;
+        return skeleton_data;
+    }
+
+    void DisposeSkeletonBlob(spSkeletonData* skeleton_data)
+    {
+        bool default_skin_disposed = false;
+        for (int i = 0; i < skeleton_data->skinsCount; ++i)
+        {
+            default_skin_disposed |= skeleton_data->skins[i] == skeleton_data->defaultSkin;
+            spSkin_dispose(skeleton_data->skins[i]);
+            skeleton_data->skins[i] = 0;
+        }
+        if (skeleton_data->defaultSkin && !default_skin_disposed)
+            spSkin_dispose(skeleton_data->defaultSkin);
+        skeleton_data->defaultSkin = 0;
+        skeleton_data->skinsCount = 0;
     }
 
 } // namespace
@@ -1,6 +1,7 @@
 #include <common/vertices.h>
 
 #include <spine/extension.h>
+#include <spine/Atlas.h>
 #include <spine/Skeleton.h>
 #include <spine/SkeletonClipping.h>
 #include <spine/Slot.h>
@@ -25,6 +26,14 @@ namespace dmSpine
         return alpha > COLOR_ALPHA_EPSILON;
     }
 
+    static inline float GetPageIndex(void* renderer_object)
+    {
+        // The attachment loader (and spSequence_apply) point the renderer object at one of our
+        // spAtlasRegion's, which stores the atlas page in its index. No atlas means page 0.
+        const spAtlasRegion* region = (const spAtlasRegion*)renderer_object;
+        return region ? (float)region->index : 0.0f;
+    }
+
     static inline bool SkipInvisibleClippedAttachment(spSkeletonClipping* skeleton_clipper, spSlot* slot, float alpha)
     {
         if (HasRenderableAlpha(alpha))
@@ -336,8 +345,22 @@ uint32_t CalcDrawDescCount(const spSkeleton* skeleton)
     return count;
 }
 
+// Transforms each unique vertex once, so that expanding the triangles only needs to copy them
+static void TransformVertices(const dmVMath::Matrix4& world, const float* vertices, uint32_t vertex_count, dmArray<dmVMath::Vector4>& out)
+{
+    EnsureArraySize(out, vertex_count);
+    const dmVMath::Vector4 col0 = world.getCol0();
+    const dmVMath::Vector4 col1 = world.getCol1();
+    const dmVMath::Vector4 col3 = world.getCol3();
+    dmVMath::Vector4* p = out.Begin();
+    for (uint32_t i = 0; i < vertex_count; ++i, vertices += 2)
+    {
+        p[i] = col0 * vertices[0] + col1 * vertices[1] + col3;
+    }
+}
+
 template <typename VertexType>
-static uint32_t GenerateVertexDataInternal(dmArray<VertexType>& vertex_buffer, const spSkeleton* skeleton, spSkeletonClipping* skeleton_clipper, const dmVMath::Matrix4& world, const dmVMath::Vector4& color_tint, dmArray<SpineDrawDesc>* draw_descs_out)
+static uint32_t GenerateVertexDataInternal(dmArray<VertexType>& vertex_buffer, const spSkeleton* skeleton, spSkeletonClipping* skeleton_clipper, const dmVMath::Matrix4& world, const dmVMath::Vector4& color_tint, dmArray<SpineDrawDesc>* draw_descs_out, dmArray<dmVMath::Vector4>& world_positions)
 {
     dmArray<float> scratch_vertex_floats;
     int vindex                  = vertex_buffer.Size();
@@ -425,6 +448,7 @@ static uint32_t GenerateVertexDataInternal(dmArray<VertexType>& vertex_buffer, c
             indices_count = ATTACHMENT_REGION_INDEX_COUNT;
             color         = attachment_color;
             vertices      = scratch_vertex_floats.Begin();
+            page_index    = GetPageIndex(regionAttachment->rendererObject);
         }
         else if (type == SP_ATTACHMENT_MESH)
         {
@@ -446,6 +470,7 @@ static uint32_t GenerateVertexDataInternal(dmArray<VertexType>& vertex_buffer, c
             indices_count = mesh->trianglesCount;
             color         = attachment_color;
             vertices      = scratch_vertex_floats.Begin();
+            page_index    = GetPageIndex(mesh->rendererObject);
         }
         else if (type == SP_ATTACHMENT_CLIPPING)
         {
@@ -480,11 +505,13 @@ static uint32_t GenerateVertexDataInternal(dmArray<VertexType>& vertex_buffer, c
         const float darkColorG = blackTintG;
         const float darkColorB = blackTintB;
 
+        TransformVertices(world, vertices, vertex_count, world_positions);
+        const dmVMath::Vector4* positions = world_positions.Begin();
         for (int i = 0; i < indices_count; ++i)
         {
-            int index = indices[i] << 1;
-            const dmVMath::Vector4 p = world * dmVMath::Point3(vertices[index], vertices[index + 1], 0.0f);
-            addVertex(&vertex_buffer[vindex++], p.getX(), p.getY(), p.getZ(), uvs[index], uvs[index + 1], colorR, colorG, colorB, colorA, darkColorR, darkColorG, darkColorB, page_index);
+            int index = indices[i];
+            const dmVMath::Vector4& p = positions[index];
+            addVertex(&vertex_buffer[vindex++], p.getX(), p.getY(), p.getZ(), uvs[index << 1], uvs[(index << 1) + 1], colorR, colorG, colorB, colorA, darkColorR, darkColorG, darkColorB, page_index);
         }
 
         if (draw_descs_out)
@@ -509,14 +536,14 @@ static uint32_t GenerateVertexDataInternal(dmArray<VertexType>& vertex_buffer, c
     return vcount;
 }
 
-uint32_t GenerateVertexData(dmArray<GuiSpineVertex>& vertex_buffer, const spSkeleton* skeleton, spSkeletonClipping* skeleton_clipper, const dmVMath::Matrix4& world, const dmVMath::Vector4& color_tint, dmArray<SpineDrawDesc>* draw_descs_out)
+uint32_t GenerateVertexData(dmArray<GuiSpineVertex>& vertex_buffer, const spSkeleton* skeleton, spSkeletonClipping* skeleton_clipper, const dmVMath::Matrix4& world, const dmVMath::Vector4& color_tint, dmArray<SpineDrawDesc>* draw_descs_out, dmArray<dmVMath::Vector4>& scratch_positions)
 {
-    return GenerateVertexDataInternal(vertex_buffer, skeleton, skeleton_clipper, world, color_tint, draw_descs_out);
+    return GenerateVertexDataInternal(vertex_buffer, skeleton, skeleton_clipper, world, color_tint, draw_descs_out, scratch_positions);
 }
 
-uint32_t GenerateVertexData(dmArray<SpineVertex>& vertex_buffer, const spSkeleton* skeleton, spSkeletonClipping* skeleton_clipper, const dmVMath::Matrix4& world, const dmVMath::Vector4& color_tint, dmArray<SpineDrawDesc>* draw_descs_out)
+uint32_t GenerateVertexData(dmArray<SpineVertex>& vertex_buffer, const spSkeleton* skeleton, spSkeletonClipping* skeleton_clipper, const dmVMath::Matrix4& world, const dmVMath::Vector4& color_tint, dmArray<SpineDrawDesc>* draw_descs_out, dmArray<dmVMath::Vector4>& scratch_positions)
 {
-    return GenerateVertexDataInternal(vertex_buffer, skeleton, skeleton_clipper, world, color_tint, draw_descs_out);
+    return GenerateVertexDataInternal(vertex_buffer, skeleton, skeleton_clipper, world, color_tint, draw_descs_out, scratch_positions);
 }
 
 uint32_t GenerateIndexedVertexData(dmArray<SpineVertex>& vertex_buffer, dmArray<uint32_t>& index_buffer, const spSkeleton* skeleton, spSkeletonClipping* skeleton_clipper, const dmVMath::Matrix4& world, const dmVMath::Vector4& color_tint, dmArray<SpineIndexedDrawDesc>* draw_descs_out, dmArray<float>& scratch_vertex_floats)
@@ -584,6 +611,7 @@ uint32_t GenerateIndexedVertexData(dmArray<SpineVertex>& vertex_buffer, dmArray<
             indices_count = ATTACHMENT_REGION_INDEX_COUNT;
             color = attachment_color;
             vertices = scratch_vertex_floats.Begin();
+            page_index = GetPageIndex(regionAttachment->rendererObject);
         }
         else if (type == SP_ATTACHMENT_MESH)
         {
@@ -603,6 +631,7 @@ uint32_t GenerateIndexedVertexData(dmArray<SpineVertex>& vertex_buffer, dmArray<
             indices_count = mesh->trianglesCount;
             color = attachment_color;
             vertices = scratch_vertex_floats.Begin();
+            page_index = GetPageIndex(mesh->rendererObject);
         }
         else if (type == SP_ATTACHMENT_CLIPPING)
         {
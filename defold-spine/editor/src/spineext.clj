@@ -82,6 +82,7 @@
 (def spine-plugin-pointer-cls (workspace/load-class! "com.dynamo.bob.pipeline.Spine$SpinePointer"))
 (def spine-plugin-aabb-cls (workspace/load-class! "com.dynamo.bob.pipeline.Spine$AABB"))
 (def spine-plugin-blendmode-cls (workspace/load-class! "com.dynamo.spine.proto.Spine$SpineModelDesc$BlendMode"))
+(def spine-plugin-blendreorder-cls (workspace/load-class! "com.dynamo.spine.proto.Spine$SpineModelDesc$BlendReorder"))
 (def spine-plugin-spinescene-cls (workspace/load-class! "com.dynamo.spine.proto.Spine$SpineSceneDesc"))
 (def spine-plugin-spinemodel-cls (workspace/load-class! "com.dynamo.spine.proto.Spine$SpineModelDesc"))
 
@@ -132,6 +133,54 @@
                         (into-array Class [spine-plugin-pointer-cls Float/TYPE float-array-cls float-array-cls Integer/TYPE])
                         [handle (float dt) (matrix4d->float-array world-transform) (color->float-array color) (int (protobuf/boolean->int use-index-buffer))]))
 
+(defn plugin-update-vertices-many [handles dt world-transforms colors use-index-buffer num-threads]
+  (let [handles (object-array handles)
+        handle-array (java.lang.reflect.Array/newInstance ^Class spine-plugin-pointer-cls (count handles))]
+    (dotimes [i (count handles)]
+      (aset ^objects handle-array i (aget handles i)))
+    ;; A nil list of transforms or colors is passed as null, and means identity for all spines.
+    ;; A nil entry in a list means identity for that spine, so the later entries stay in place.
+    (plugin-invoke-static spine-plugin-cls "SPINE_UpdateVerticesMany"
+                          (into-array Class [(class handle-array) Integer/TYPE Float/TYPE float-array-cls float-array-cls Integer/TYPE Integer/TYPE])
+                          [handle-array (int (count handles)) (float dt)
+                           (some->> world-transforms seq (mapcat #(geom/as-array (or % geom/Identity4d))) float-array)
+                           (some->> colors seq (mapcat #(or % identity-color)) float-array)
+                           (int (protobuf/boolean->int use-index-buffer))
+                           (int num-threads)])))
+
+(def ^:private update-vertices-num-threads
+  (.availableProcessors (Runtime/getRuntime)))
+
+;; The scene updatables only queue their time steps here. The queue is flushed right before
+;; the spines are rendered, with one SPINE_UpdateVerticesMany call per distinct dt.
+(defonce ^:private pending-steps (atom {}))
+
+(defn enqueue-step! [handle dt]
+  (swap! pending-steps update handle (fnil + 0.0) dt))
+
+(defn flush-pending-steps! []
+  (let [[steps _] (swap-vals! pending-steps empty)]
+    (doseq [[dt entries] (group-by val steps)]
+      (plugin-update-vertices-many (map key entries) dt nil nil false update-vertices-num-threads))))
+
+(defn update-vertices-many!
+  "Applies any queued time steps, and then updates the vertices of all handles for rendering.
+  Each handle may only be given once, see shared-handles."
+  [handles world-transforms colors use-index-buffer]
+  (flush-pending-steps!)
+  (when (seq handles)
+    (plugin-update-vertices-many handles 0.0 world-transforms colors use-index-buffer update-vertices-num-threads)))
+
+(defn shared-handles
+  "Returns the set of handles that appear more than once. A handle only holds the vertices of
+  its last update, so renderables sharing one must each be updated right before they're read."
+  [handles]
+  (into #{}
+        (keep (fn [[handle n]]
+                (when (> n 1)
+                  handle)))
+        (frequencies handles)))
+
 ;(defn- plugin-get-bones ^"[Lcom.dynamo.bob.pipeline.Spine$Bone;" [handle]
 (defn plugin-get-bones [handle]
   (plugin-invoke-static spine-plugin-cls "SPINE_GetBones" (into-array Class [spine-plugin-pointer-cls]) [handle]))
@@ -277,7 +326,6 @@
 
 (defn renderable->render-data [renderable]
   (let [handle (renderable->handle renderable)
-        _ (plugin-update-vertices handle 0.0 (:world-transform renderable) identity-color true)
         vb-data (plugin-get-vertex-buffer-byte-buffer handle)
         ib-data (plugin-get-index-buffer-byte-buffer handle)
         vertex-buffer-version (plugin-get-vertex-buffer-version handle)
@@ -296,7 +344,15 @@
 
 
 (defn collect-render-groups [renderables]
-  (map renderable->render-data renderables))
+  (let [shared? (shared-handles (map renderable->handle renderables))
+        unique-renderables (into [] (remove (comp shared? renderable->handle)) renderables)]
+    (update-vertices-many! (mapv renderable->handle unique-renderables) (map :world-transform unique-renderables) nil true)
+    (mapv (fn [renderable]
+            (let [handle (renderable->handle renderable)]
+              (when (shared? handle)
+                (plugin-update-vertices handle 0.0 (:world-transform renderable) identity-color true))
+              (renderable->render-data renderable)))
+          renderables)))
 
 (defn- blend-factor-value-to-blend-mode [blend-factor-value]
   (case (long blend-factor-value)
@@ -743,14 +799,16 @@
 
 ;;//////////////////////////////////////////////////////////////////////////////////////////////
 
-(g/defnk produce-model-pb [spine-scene-resource blend-mode default-animation skin material-resource create-go-bones playback-rate offset]
+(g/defnk produce-model-pb [spine-scene-resource blend-mode blend-reorder default-animation skin material-resource create-go-bones go-bones playback-rate offset]
   (protobuf/make-map-without-defaults spine-plugin-spinemodel-cls
     :spine-scene (resource/resource->proj-path spine-scene-resource)
     :default-animation default-animation
     :skin skin
     :material (resource/resource->proj-path material-resource)
     :blend-mode blend-mode
+    :blend-reorder blend-reorder
     :create-go-bones create-go-bones
+    :go-bones go-bones
     :playback-rate playback-rate
     :offset offset))
 
@@ -821,8 +879,10 @@
         default-animation :default-animation
         skin :skin
         blend-mode :blend-mode
+        blend-reorder :blend-reorder
         material (resolve-resource (:material :or spine-material-path))
         create-go-bones :create-go-bones
+        go-bones :go-bones
         playback-rate :playback-rate
         offset :offset))))
 
@@ -831,7 +891,7 @@
   (when (not (nil? spine-data-handle))
     (plugin-set-skin spine-data-handle skin)
     (plugin-set-animation spine-data-handle animation)
-    (plugin-update-vertices spine-data-handle dt geom/Identity4d identity-color false))
+    (enqueue-step! spine-data-handle dt))
   state)
 
 (g/defnk produce-spine-data-handle-updatable [_node-id spine-data-handle default-animation skin]
@@ -865,6 +925,9 @@
   (property blend-mode g/Any (default :blend-mode-alpha)
             (dynamic tip (validation/blend-mode-tip blend-mode spine-plugin-blendmode-cls))
             (dynamic edit-type (g/constantly (properties/->pb-choicebox spine-plugin-blendmode-cls))))
+  (property blend-reorder g/Any (default :blend-reorder-none)
+            (dynamic visible (g/fnk [blend-mode] (= blend-mode :blend-mode-inherit)))
+            (dynamic edit-type (g/constantly (properties/->pb-choicebox spine-plugin-blendreorder-cls))))
   (property material resource/Resource
             (value (gu/passthrough material-resource))
             (set (fn [evaluation-context self old-value new-value]
@@ -885,6 +948,8 @@
                              (validate-model-skin _node-id spine-scene skins skin)))
             (dynamic edit-type (g/fnk [skins] (->skin-choicebox skins))))
   (property create-go-bones g/Bool (default false))
+  (property go-bones g/Str (default "")
+            (dynamic visible (g/fnk [create-go-bones] create-go-bones)))
   (property playback-rate g/Num (default (float 1.0)))
   (property offset g/Num (default (float 0.0))
             (dynamic edit-type (g/constantly {:type :slider
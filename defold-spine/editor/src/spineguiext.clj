@@ -69,18 +69,15 @@
   (when-not (g/error? (validate-spine-scene node-id spine-scene-names spine-scene))
     (spineext/validate-skin node-id :spine-skin spine-skin-ids spine-skin)))
 
-(defn- update-vertices! [handle skin anim dt world-transform color]
-  (when (some? handle)
-    (when-not (str/blank? skin)
-      (spineext/plugin-set-skin handle skin))
-    (when-not (str/blank? anim)
-      (spineext/plugin-set-animation handle anim))
-    (spineext/plugin-update-vertices handle dt world-transform color false)))
-
-(defn- produce-vertices [handle skin anim dt world-transform color]
+(defn- set-skin-and-animation! [handle skin anim]
+  (when-not (str/blank? skin)
+    (spineext/plugin-set-skin handle skin))
+  (when-not (str/blank? anim)
+    (spineext/plugin-set-animation handle anim)))
+
+(defn- produce-vertices [handle]
   (if (some? handle)
-    (let [_ (update-vertices! handle skin anim dt world-transform color)
-          vb-data (spineext/plugin-get-vertex-buffer-data handle)] ; list of SpineVertex
+    (let [vb-data (spineext/plugin-get-vertex-buffer-data handle)] ; list of SpineVertex
       (into [] (spineext/transform-vertices-as-vec vb-data))) ; unpacked into lists of lists [[x y z u v r g b a page_index]])
     []))
 
@@ -91,21 +88,42 @@
     {:node-id _node-id
      :name "Spine GUI Updater"
      :update-fn (fn [state {:keys [dt]}]
-                  (update-vertices! spine-data-handle spine-skin spine-default-animation dt geom/Identity4d spineext/identity-color)
+                  (set-skin-and-animation! spine-data-handle spine-skin spine-default-animation)
+                  (spineext/enqueue-step! spine-data-handle dt)
                   state)
      :initial-state {}}))
 
-(defn- renderable->vertices [renderable]
-  (let [handle (spineext/renderable->handle renderable)
-        world-transform (:world-transform renderable)
-        per-node-user-data (:user-data renderable)
-        skin (:spine-skin per-node-user-data)
-        anim (:spine-default-animation per-node-user-data)
-        color (:color per-node-user-data)]
-    (produce-vertices handle skin anim 0.0 world-transform color)))
+(defn- renderable->color [renderable]
+  (or (:color (:user-data renderable)) spineext/identity-color))
+
+(defn- set-renderable-skin-and-animation! [renderable]
+  (let [per-node-user-data (:user-data renderable)]
+    (set-skin-and-animation! (spineext/renderable->handle renderable)
+                             (:spine-skin per-node-user-data)
+                             (:spine-default-animation per-node-user-data))))
+
+;; Renderables sharing a handle are left out of the batch, and updated one at a time in
+;; renderable->vertices instead, see spineext/shared-handles.
+(defn- update-renderable-vertices! [renderables shared?]
+  (let [renderables (into [] (remove (comp shared? spineext/renderable->handle)) renderables)]
+    (run! set-renderable-skin-and-animation! renderables)
+    (spineext/update-vertices-many! (mapv spineext/renderable->handle renderables)
+                                    (map :world-transform renderables)
+                                    (map renderable->color renderables)
+                                    false)))
+
+(defn- renderable->vertices [shared? renderable]
+  (let [handle (spineext/renderable->handle renderable)]
+    (when (shared? handle)
+      (set-renderable-skin-and-animation! renderable)
+      (spineext/plugin-update-vertices handle 0.0 (:world-transform renderable) (renderable->color renderable) false))
+    (produce-vertices handle)))
 
 (defn- gen-vb [_user-data renderables]
-  (let [vertices (into [] (mapcat renderable->vertices) renderables)
+  (let [renderables (filterv spineext/renderable->handle renderables)
+        shared? (spineext/shared-handles (map spineext/renderable->handle renderables))
+        _ (update-renderable-vertices! renderables shared?)
+        vertices (into [] (mapcat (partial renderable->vertices shared?)) renderables)
         vb-out (spineext/generate-vertex-buffer vertices)]
     vb-out))
 
@@ -2,15 +2,19 @@
 #define DM_SPINE_ATTACHMENT_LOADER_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 extern "C" {
 #include <spine/AttachmentLoader.h>
 }
 
+#include <dmsdk/dlib/array.h>
+#include <dmsdk/dlib/hash.h>
 #include <dmsdk/dlib/hashtable.h>
 
 struct spAtlasRegion;
 struct spSkeletonData;
+struct spAnimation;
 
 namespace dmGameSystemDDF
 {
@@ -24,6 +28,16 @@ namespace dmGameSystem
 
 namespace dmSpine
 {
+    // Where the time goes in the last ReadSkeletonData() call (in microseconds)
+    struct SkeletonLoadProfile
+    {
+        uint64_t m_Total;
+        uint64_t m_Attachments;         // Creating the attachments, including the region lookups
+        uint64_t m_Sequences;           // Part of m_Attachments, resolving the sequence frames
+        uint32_t m_AttachmentCount;
+        uint32_t m_SequenceFrameCount;
+    };
+
     // Using their naming convention here
     typedef struct spDefoldAtlasAttachmentLoader {
         spAttachmentLoader                  super;
@@ -31,23 +45,93 @@ namespace dmSpine
         spAtlasRegion*                      default_region;
         dmGameSystemDDF::TextureSet*        texture_set_ddf;
         dmHashTable64<uint32_t>*            name_to_index;
+        bool                                owns_name_to_index;
+        SkeletonLoadProfile                 profile;
     } spDefoldAtlasAttachmentLoader;
 
+    // The atlas page index of each region is stored in spAtlasRegion::index
     spAtlasRegion* CreateRegions(dmGameSystemDDF::TextureSet* texture_set_ddf);
 
+    // Hash of the region data of the atlas, to tell if regions created earlier are still valid for it
+    dmhash_t HashRegions(dmGameSystemDDF::TextureSet* texture_set_ddf);
+
+    // Maps the atlas animation names to their index in the regions array
+    dmHashTable64<uint32_t>* CreateRegionNameToIndex(dmGameSystemDDF::TextureSet* texture_set_ddf);
+
     // It will keep pointer from the regions array
     spDefoldAtlasAttachmentLoader* CreateAttachmentLoader(dmGameSystemDDF::TextureSet* texture_set_ddf, spAtlasRegion* regions);
 
+    // Uses a region table shared with other loaders. Neither the regions nor the name_to_index table are owned by the loader.
+    spDefoldAtlasAttachmentLoader* CreateAttachmentLoader(spAtlasRegion* regions, dmHashTable64<uint32_t>* name_to_index);
+
     // Used to load the skeleton data, without the need for any correct uv coordinates
     spDefoldAtlasAttachmentLoader* CreateAttachmentLoader();
 
     void Dispose(spDefoldAtlasAttachmentLoader* loader);
 
+    // True for .skel/.skelc paths. Binary data is read using its length, JSON data must be null terminated.
+    bool IsBinarySkeletonPath(const char* path);
+
+    enum ReadAnimationsMode
+    {
+        READ_ANIMATIONS_ALL,    // Decode all animations
+        READ_ANIMATIONS_NONE,   // Leave the animations empty (see BorrowAnimations)
+        READ_ANIMATIONS_LAZY,   // Binary data only. Create the animations without timelines (see ReadAnimationTimelines)
+    };
+
     // Loads binary data for .skel/.skelc paths and JSON data for all other paths.
-    spSkeletonData* ReadSkeletonData(spAttachmentLoader* loader, const char* path, const void* data, size_t data_size);
+    // The loader must be created with CreateAttachmentLoader(), and its profile is updated.
+    // With READ_ANIMATIONS_LAZY, the offset of each animation is stored in animation_offsets. JSON data is always fully read.
+    spSkeletonData* ReadSkeletonData(spAttachmentLoader* loader, const char* path, const void* data, size_t data_size,
+                                        ReadAnimationsMode mode = READ_ANIMATIONS_ALL, dmArray<uint32_t>* animation_offsets = 0);
 
     // Kept for callers that explicitly load JSON data.
-    spSkeletonData* ReadSkeletonJsonData(spAttachmentLoader* loader, const char* path, void* json_data);
+    spSkeletonData* ReadSkeletonJsonData(spAttachmentLoader* loader, const char* path, void* json_data, ReadAnimationsMode mode = READ_ANIMATIONS_ALL);
+
+    // Decodes the timelines of an animation read with READ_ANIMATIONS_LAZY, from the same binary data
+    bool ReadAnimationTimelines(spAttachmentLoader* loader, const char* path, spSkeletonData* skeleton_data, const void* data, size_t data_size,
+                                uint32_t offset, spAnimation* animation);
+
+    // True if the animations may be shared with skeleton data read from the same file, but with another atlas
+    bool CanShareAnimations(spSkeletonData* skeleton_data);
+
+    // Lets skeleton_data (read without animations) use the animations of owner, which was read from the same file.
+    // The owner must outlive it, and ReturnAnimations() must be called before disposing skeleton_data.
+    void BorrowAnimations(spSkeletonData* skeleton_data, spSkeletonData* owner);
+    void ReturnAnimations(spSkeletonData* skeleton_data);
+
+    static const uint32_t SKELETON_BLOB_MAGIC   = 0x424C4B53; // 'SKLB'
+    static const uint32_t SKELETON_BLOB_VERSION = 1;
+
+    // A precompiled spSkeletonData (see LoadSkeletonBlob), written by the bob plugin. The skeleton data and everything
+    // it points to is stored after the header, with each pointer stored as an offset from the start of the blob.
+    struct SkeletonBlobHeader
+    {
+        uint32_t m_Magic;
+        uint32_t m_Version;
+        uint64_t m_LayoutHash;          // GetSkeletonBlobLayoutHash() of the writer
+        uint64_t m_RegionsHash;         // HashRegions() of the atlas the attachments were created with
+        uint32_t m_Size;                // Including the header
+        uint32_t m_Loaded;              // Set once the blob is in use, after which it can't be loaded again
+        uint32_t m_SkeletonData;        // Offset of the spSkeletonData
+        uint32_t m_Relocations;         // Offset of the uint32_t offsets of all pointers
+        uint32_t m_RelocationCount;
+        uint32_t m_Attachments;         // Offset of the uint32_t offsets of all attachments
+        uint32_t m_AttachmentCount;
+        uint32_t m_Timelines;           // Offset of the uint32_t offsets of all timelines
+        uint32_t m_TimelineCount;
+        uint32_t m_Reserved;
+    };
+
+    // Hash of the pointer size and the spine struct sizes. Blobs are only loaded by a runtime with the same layout.
+    uint64_t GetSkeletonBlobLayoutHash();
+
+    // Relocates the pointers in place (the blob must be 8 byte aligned) and restores the function pointers.
+    // Returns 0 if the blob isn't valid for this runtime, or if it was made for other atlas regions.
+    // The skins are recreated on the heap, since they may be changed at runtime. Everything else stays in the blob,
+    // which must outlive the skeleton data. Use DisposeSkeletonBlob() instead of spSkeletonData_dispose().
+    spSkeletonData* LoadSkeletonBlob(void* blob, uint32_t blob_size, dmhash_t regions_hash);
+    void DisposeSkeletonBlob(spSkeletonData* skeleton_data);
 
 } // namespace
 
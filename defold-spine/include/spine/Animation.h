@@ -180,6 +180,9 @@ struct spTimeline {
 
 SP_API void spTimeline_dispose(spTimeline *self);
 
+/* Defold: sets the vtable from the timeline type, for timelines that weren't created in this process */
+SP_API int _spTimeline_restoreVtable(spTimeline *self);
+
 SP_API void
 spTimeline_apply(spTimeline *self, struct spSkeleton *skeleton, float lastTime, float time, spEvent **firedEvents,
 				 int *eventsCount, float alpha, spMixBlend blend, spMixDirection direction);
@@ -195,8 +198,12 @@ SP_API float spTimeline_getDuration(const spTimeline *self);
 typedef struct spCurveTimeline {
 	spTimeline super;
 	spFloatArray *curves; /* type, x, y, ... */
+	int compact; /* Defold: beziers are stored as cx1, cy1, cx2, cy2 instead of sampled points */
 } spCurveTimeline;
 
+/* Defold: timelines created after this call store their beziers compactly (see spCurveTimeline::compact) */
+SP_API void spCurveTimeline_setCompactCurves(int compact);
+
 SP_API void spCurveTimeline_setLinear(spCurveTimeline *self, int frameIndex);
 
 SP_API void spCurveTimeline_setStepped(spCurveTimeline *self, int frameIndex);
@@ -46,6 +46,11 @@ typedef struct spSkeletonBinary {
 	float scale;
 	spAttachmentLoader *attachmentLoader;
 	char *error;
+	int skipAnimations; /* Defold: leaves the animations empty, for skeleton data that borrows them from another instance. */
+	/* Defold: creates the animations without timelines, only with their name and duration. The offset of each
+	 * animation into the binary data is stored in animationOffsets, see spSkeletonBinary_readAnimationTimelines. */
+	int lazyAnimations;
+	int *animationOffsets;
 } spSkeletonBinary;
 
 SP_API spSkeletonBinary *spSkeletonBinary_createWithLoader(spAttachmentLoader *attachmentLoader);
@@ -59,6 +64,11 @@ spSkeletonBinary_readSkeletonData(spSkeletonBinary *self, const unsigned char *b
 
 SP_API spSkeletonData *spSkeletonBinary_readSkeletonDataFile(spSkeletonBinary *self, const char *path);
 
+/* Defold: decodes the timelines of an animation created with lazyAnimations. The binary data must be the same
+ * that the skeleton data was read from. Returns 0 on failure, leaving the animation empty. */
+SP_API int spSkeletonBinary_readAnimationTimelines(spSkeletonBinary *self, const unsigned char *binary, const int length,
+												   int offset, spSkeletonData *skeletonData, spAnimation *animation);
+
 #ifdef __cplusplus
 }
 #endif
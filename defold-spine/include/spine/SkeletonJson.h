@@ -47,6 +47,7 @@ typedef struct spSkeletonJson {
 	float scale;
 	spAttachmentLoader *attachmentLoader;
 	char *error;
+	int skipAnimations; /* Defold: leaves the animations empty, for skeleton data that borrows them from another instance. */
 } spSkeletonJson;
 
 SP_API spSkeletonJson *spSkeletonJson_createWithLoader(spAttachmentLoader *attachmentLoader);
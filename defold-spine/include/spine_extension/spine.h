@@ -0,0 +1,77 @@
+// Copyright 2020 The Defold Foundation
+// Licensed under the Defold License version 1.0 (the "License"); you may not use
+// this file except in compliance with the License.
+//
+// You may obtain a copy of the License, together with FAQs at
+// https://www.defold.com/license
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef DMSDK_SPINE_EXTENSION_SPINE_H
+#define DMSDK_SPINE_EXTENSION_SPINE_H
+
+#include <stdint.h>
+#include <dmsdk/dlib/hash.h>
+#include <dmsdk/dlib/vmath.h>
+#include <dmsdk/script/script.h>
+
+/*# Spine extension native API documentation
+ *
+ * Functions for other native extensions to read the pose of a spine model,
+ * without creating game objects for its bones.
+ *
+ * @document
+ * @name Spine
+ * @namespace dmSpine
+ * @path spine_extension/spine.h
+ */
+
+namespace dmSpine
+{
+    struct SpineModelComponent;
+
+    /*# Spine model handle
+     * The handle is valid until the spine model component is deleted.
+     * @typedef
+     * @name HSpineModel
+     */
+    typedef SpineModelComponent* HSpineModel;
+
+    /*# get a spine model from a script argument
+     * Resolves the url at the given stack index to a spine model component.
+     * Raises a Lua error if the url doesn't point to a spine model.
+     *
+     * @name GetSpineModel
+     * @param L [type:lua_State*] the Lua state
+     * @param index [type:int] stack index of the url (string, hash or url)
+     * @return model [type:HSpineModel] the spine model
+     */
+    HSpineModel GetSpineModel(lua_State* L, int index);
+
+    /*# get the index of a bone
+     * The index stays valid as long as the spine scene of the model isn't changed.
+     *
+     * @name GetBoneIndex
+     * @param model [type:HSpineModel] the spine model
+     * @param bone_id [type:dmhash_t] hashed bone name
+     * @return index [type:int32_t] the bone index, or -1 if there is no such bone
+     */
+    int32_t GetBoneIndex(HSpineModel model, dmhash_t bone_id);
+
+    /*# get the world transforms of bones
+     * Reads the world transforms of the bones, as of the last update of the model.
+     *
+     * @name GetBoneWorldTransforms
+     * @param model [type:HSpineModel] the spine model
+     * @param bone_indices [type:const int32_t*] the bone indices, from GetBoneIndex()
+     * @param count [type:uint32_t] the number of bones
+     * @param out [type:dmVMath::Matrix4*] array of (at least) count matrices that receive the world transforms
+     * @return result [type:bool] false if the model has no skeleton, or if any of the indices are invalid
+     */
+    bool GetBoneWorldTransforms(HSpineModel model, const int32_t* bone_indices, uint32_t count, dmVMath::Matrix4* out);
+}
+
+#endif // DMSDK_SPINE_EXTENSION_SPINE_H
@@ -13,6 +13,8 @@ import java.io.InputStream;
 import java.nio.Buffer;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
+import java.nio.file.Files;
+import java.nio.file.Paths;
 import java.util.List;
 import java.util.Arrays;
 
@@ -27,6 +29,8 @@ public class Spine {
     static {
         try {
             Native.register("SpineExt");
+            // The vertex update workers are kept alive between updates
+            Runtime.getRuntime().addShutdownHook(new Thread(() -> SPINE_ShutdownUpdateVertices()));
         } catch (Exception e) {
             System.out.println("FATAL: " + e.getMessage());
         }
@@ -53,6 +57,10 @@ public class Spine {
     public static native Pointer SPINE_LoadFromPath(String path, String atlas_path);
     public static native Pointer SPINE_LoadFromBuffer(Buffer buffer, int bufferSize, String path, Buffer atlas_buffer, int atlas_bufferSize, String atlas_path);
     public static native void SPINE_Destroy(SpinePointer spine);
+    public static native double SPINE_BenchmarkLoad(Buffer buffer, int bufferSize, String path, Buffer atlas_buffer, int atlas_bufferSize, String atlas_path, int iterations);
+    public static native double SPINE_BenchmarkLoadBlob(Buffer buffer, int bufferSize, String path, Buffer atlas_buffer, int atlas_bufferSize, String atlas_path, int iterations);
+    public static native Pointer SPINE_WriteSkeletonBlob(Buffer buffer, int bufferSize, String path, Buffer atlas_buffer, int atlas_bufferSize, String atlas_path, int compactCurves, IntByReference size);
+    public static native void SPINE_FreeSkeletonBlob(Pointer blob);
 
     // TODO: Create a jna Structure for this
     // Structures in JNA
@@ -150,6 +158,10 @@ public class Spine {
 
     public static native void SPINE_UpdateVertices(SpinePointer spine, float dt, float[] worldTransform, float[] colorTint, int useIndexBuffer);
 
+    // Updates all spines in one native call. The transforms (16 floats each) and tints (4 floats each) are laid out per spine.
+    public static native void SPINE_UpdateVerticesMany(SpinePointer[] spines, int count, float dt, float[] worldTransforms, float[] colorTints, int useIndexBuffer, int numThreads);
+    public static native void SPINE_ShutdownUpdateVertices();
+
     public static native int SPINE_GetVertexSize(); // size in bytes per vertex
 
 
@@ -322,6 +334,20 @@ public class Spine {
         return new SpinePointer(p);
     }
 
+    // Returns the skeleton in the precompiled format loaded by the runtime (see SpineSceneDesc.precompiled_skeleton)
+    public static byte[] SPINE_WriteSkeletonBlob(byte[] spine_data, String path, byte[] atlas_buffer, String atlas_path, boolean compactCurves) throws SpineException {
+        Buffer b = ByteBuffer.wrap(spine_data);
+        Buffer a = ByteBuffer.wrap(atlas_buffer);
+        IntByReference size = new IntByReference();
+        Pointer p = SPINE_WriteSkeletonBlob(b, b.capacity(), path, a, a.capacity(), atlas_path, compactCurves ? 1 : 0, size);
+        if (p == null) {
+            throw new SpineException(String.format("Failed to precompile spine scene '%s' with atlas '%s': %s", path, atlas_path, SPINE_GetLastError()));
+        }
+        byte[] blob = p.getByteArray(0, size.getValue());
+        SPINE_FreeSkeletonBlob(p);
+        return blob;
+    }
+
     // public static void SPINE_GetVertices(SpinePointer spine, float[] buffer){
     //     Buffer b = FloatBuffer.wrap(buffer);
     //     SPINE_GetVertices(spine, b, b.capacity()*4);
@@ -329,9 +355,37 @@ public class Spine {
 
     private static void Usage() {
         System.out.printf("Usage: pluginSpineExt.jar <.spinejson|.skel> <.texturesetc>\n");
+        System.out.printf("       pluginSpineExt.jar --benchmark <iterations> <.texturesetc> <.spinejson|.skel>...\n");
         System.out.printf("\n");
     }
 
+    // Compare the load times of different skeleton files (e.g. the .spinejson and .skel export of the same skeleton)
+    private static void Benchmark(String[] args) throws IOException {
+        int iterations = Integer.parseInt(args[1]);
+        String atlas_path = args[2];
+        byte[] atlas_data = Files.readAllBytes(Paths.get(atlas_path));
+        Buffer a = ByteBuffer.wrap(atlas_data);
+
+        for (int i = 3; i < args.length; ++i) {
+            String path = args[i];
+            byte[] data = Files.readAllBytes(Paths.get(path));
+            Buffer b = ByteBuffer.wrap(data);
+            double us = SPINE_BenchmarkLoad(b, b.capacity(), path, a, a.capacity(), atlas_path, iterations);
+            if (us < 0) {
+                System.err.printf("Failed to load %s: %s\n", path, SPINE_GetLastError());
+                continue;
+            }
+            System.out.printf("%s: %d bytes  %.3f ms/load  (%d iterations)\n", path, data.length, us / 1000.0, iterations);
+
+            double blob_us = SPINE_BenchmarkLoadBlob(b, b.capacity(), path, a, a.capacity(), atlas_path, iterations);
+            if (blob_us < 0) {
+                System.err.printf("Failed to load %s precompiled: %s\n", path, SPINE_GetLastError());
+                continue;
+            }
+            System.out.printf("%s (precompiled): %.3f ms/load  (%d iterations)\n", path, blob_us / 1000.0, iterations);
+        }
+    }
+
     private static void DebugPrintBone(Bone bone, Bone[] bones, int indent) {
         String tab = " ".repeat(indent * 4);
         System.out.printf("Bone:%s %s: idx: %d parent = %d, pos: %f, %f  scale: %f, %f  rot: %f  length: %f\n",
@@ -358,6 +412,11 @@ public class Spine {
     public static void main(String[] args) throws IOException {
         System.setProperty("java.awt.headless", "true");
 
+        if (args.length >= 4 && args[0].equals("--benchmark")) {
+            Benchmark(args);
+            return;
+        }
+
         if (args.length < 2) {
             Usage();
             return;
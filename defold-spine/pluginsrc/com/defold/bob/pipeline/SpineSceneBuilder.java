@@ -9,6 +9,7 @@ import com.dynamo.bob.fs.IResource;
 import com.dynamo.bob.pipeline.BuilderUtil;
 import com.dynamo.spine.proto.Spine.SpineSceneDesc;
 import com.dynamo.bob.pipeline.Spine;
+import com.google.protobuf.ByteString;
 
 import java.io.IOException;
 import java.nio.Buffer;
@@ -35,9 +36,44 @@ public class SpineSceneBuilder extends ProtoBuilder<SpineSceneDesc.Builder> {
         }
         builder.setAtlas(BuilderUtil.replaceExt(path, ".atlas", ".a.texturesetc"));
 
+        if (shouldPrecompileSkeleton()) {
+            builder.setPrecompiledSkeleton(ByteString.copyFrom(precompileSkeleton(task)));
+        }
+
         return builder;
     }
 
+    // The precompiled skeleton has the memory layout of a 64 bit runtime. Other runtimes (e.g. armv7 in a
+    // multi architecture bundle) don't accept it, and read the spine data as usual.
+    private boolean shouldPrecompileSkeleton() {
+        if (!this.project.getProjectProperties().getBooleanValue("spine", "precompile_skeletons", false)) {
+            return false;
+        }
+        String platform = this.project.option("platform", "");
+        return platform.isEmpty() || platform.startsWith("x86_64-") || platform.startsWith("arm64-");
+    }
+
+    private byte[] precompileSkeleton(Task task) throws CompileExceptionError {
+        IResource texturec = null;
+        IResource spineData = null;
+        for (IResource input: task.getInputs()) {
+            String path = input.getPath();
+            if (path.endsWith("texturesetc")) {
+                texturec = input;
+            }
+            else if (path.endsWith("spinejsonc") || path.endsWith("skelc")) {
+                spineData = input;
+            }
+        }
+        boolean compactCurves = this.project.getProjectProperties().getBooleanValue("spine", "compact_curves", false);
+        try {
+            return Spine.SPINE_WriteSkeletonBlob(spineData.getContent(), spineData.getPath(), texturec.getContent(), texturec.getPath(), compactCurves);
+        }
+        catch (IOException | Spine.SpineException e) {
+            throw new CompileExceptionError(task.getInputs().get(0), -1, e.getMessage());
+        }
+    }
+
     @Override
     public void build(Task task) throws CompileExceptionError, IOException {
         super.build(task);
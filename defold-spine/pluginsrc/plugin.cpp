@@ -15,13 +15,18 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <dmsdk/sdk.h>
 #include <dmsdk/dlib/array.h>
+#include <dmsdk/dlib/condition_variable.h>
 #include <dmsdk/dlib/log.h>
 #include <dmsdk/dlib/math.h>
+#include <dmsdk/dlib/mutex.h>
 #include <dmsdk/dlib/dstrings.h>
 #include <dmsdk/dlib/shared_library.h>
+#include <dmsdk/dlib/thread.h>
+#include <dmsdk/dlib/time.h>
 #include <dmsdk/ddf/ddf.h>
 #include <dmsdk/gamesys/resources/res_textureset.h>
 #include <gamesys/texture_set_ddf.h>
@@ -35,6 +40,8 @@
 #include <spine/Skeleton.h>
 #include <spine/SkeletonClipping.h>
 
+#include "skeleton_blob.h"
+
 static const dmhash_t UNIFORM_TINT = dmHashString64("tint");
 
 struct AABB
@@ -68,8 +75,9 @@ struct SpineFile
     dmArray<uint32_t>                       m_IndexBuffer;
     dmArray<dmSpine::SpineIndexedDrawDesc>  m_DrawDescs;
     dmArray<dmSpine::SpineIndexedDrawDesc>  m_DrawDescScratch;
-    dmArray<dmSpine::SpineIndexedDrawDesc>  m_MergedDrawDescScratch;
     dmArray<float>                           m_GeometryScratch;
+    dmArray<dmVMath::Vector4>               m_PositionScratch;
+    spSkeletonClipping*                     m_SkeletonClipper; // Kept per file, so that files can be updated in parallel
     uint32_t                                m_VertexBufferVersion;
     uint32_t                                m_IndexBufferVersion;
     dmhash_t                                m_CurrentSkin;
@@ -85,6 +93,7 @@ struct SpineFile
     , m_AttachmentLoader(0)
     , m_SkeletonInstance(0)
     , m_AnimationStateInstance(0)
+    , m_SkeletonClipper(0)
     , m_VertexBufferVersion(0)
     , m_IndexBufferVersion(0)
     , m_CurrentSkin(0)
@@ -338,6 +347,134 @@ extern "C" DM_DLLEXPORT void* SPINE_LoadFromBuffer(void* spine_data, size_t spin
     return (void*)file;
 }
 
+// Measures the average time (in microseconds) to parse, and dispose, the skeleton data.
+// Returns a negative value if the data couldn't be loaded.
+extern "C" DM_DLLEXPORT double SPINE_BenchmarkLoad(void* spine_data, size_t spine_data_size, const char* path, void* atlas_buffer, size_t atlas_size, const char* atlas_path, int iterations)
+{
+    dmGameSystemDDF::TextureSet* texture_set_ddf = 0;
+    if (atlas_buffer)
+    {
+        texture_set_ddf = LoadAtlasFromBuffer(atlas_buffer, atlas_size, atlas_path);
+        if (!texture_set_ddf)
+            return -1.0;
+    }
+
+    spAtlasRegion* regions = texture_set_ddf ? dmSpine::CreateRegions(texture_set_ddf) : 0;
+    dmSpine::spDefoldAtlasAttachmentLoader* loader = texture_set_ddf ? dmSpine::CreateAttachmentLoader(texture_set_ddf, regions) : dmSpine::CreateAttachmentLoader();
+
+    // The json parser needs a null terminated string, which we don't want to include in the timing
+    char* data = (char*)malloc(spine_data_size + 1);
+    memcpy(data, spine_data, spine_data_size);
+    data[spine_data_size] = 0;
+
+    double result = 0.0;
+    uint64_t start = dmTime::GetMonotonicTime();
+    for (int i = 0; i < iterations; ++i)
+    {
+        spSkeletonData* skeleton_data = dmSpine::ReadSkeletonData((spAttachmentLoader*)loader, path, data, spine_data_size);
+        if (!skeleton_data)
+        {
+            SPINE_SetLastError((spAttachmentLoader*)loader);
+            result = -1.0;
+            break;
+        }
+        spSkeletonData_dispose(skeleton_data);
+    }
+    if (result == 0.0 && iterations > 0)
+        result = (dmTime::GetMonotonicTime() - start) / (double)iterations;
+
+    free(data);
+    dmSpine::Dispose(loader);
+    delete[] regions;
+    if (texture_set_ddf)
+        DestroyAtlas(texture_set_ddf);
+    return result;
+}
+
+// Reads the skeleton data with the atlas regions, and writes it in the precompiled format (see dmSpine::LoadSkeletonBlob).
+// Returns a buffer to free with SPINE_FreeSkeletonBlob(), or 0 if it couldn't be written.
+extern "C" DM_DLLEXPORT void* SPINE_WriteSkeletonBlob(void* spine_data, size_t spine_data_size, const char* path, void* atlas_buffer, size_t atlas_size, const char* atlas_path, int compact_curves, int* out_size)
+{
+    *out_size = 0;
+    dmGameSystemDDF::TextureSet* texture_set_ddf = LoadAtlasFromBuffer(atlas_buffer, atlas_size, atlas_path);
+    if (!texture_set_ddf)
+        return 0;
+
+    spAtlasRegion* regions = dmSpine::CreateRegions(texture_set_ddf);
+    dmSpine::spDefoldAtlasAttachmentLoader* loader = dmSpine::CreateAttachmentLoader(texture_set_ddf, regions);
+    dmhash_t regions_hash = dmSpine::HashRegions(texture_set_ddf);
+
+    // The json parser needs a null terminated string
+    char* data = (char*)malloc(spine_data_size + 1);
+    memcpy(data, spine_data, spine_data_size);
+    data[spine_data_size] = 0;
+
+    spCurveTimeline_setCompactCurves(compact_curves);
+    spSkeletonData* skeleton_data = dmSpine::ReadSkeletonData((spAttachmentLoader*)loader, path, data, spine_data_size);
+    spCurveTimeline_setCompactCurves(0);
+
+    void* blob = 0;
+    if (skeleton_data)
+    {
+        uint32_t size = 0;
+        blob = dmSpine::WriteSkeletonBlob(skeleton_data, regions_hash, &size);
+        *out_size = (int)size;
+        spSkeletonData_dispose(skeleton_data);
+    }
+    else
+    {
+        SPINE_SetLastError((spAttachmentLoader*)loader);
+    }
+
+    free(data);
+    dmSpine::Dispose(loader);
+    delete[] regions;
+    DestroyAtlas(texture_set_ddf);
+    return blob;
+}
+
+extern "C" DM_DLLEXPORT void SPINE_FreeSkeletonBlob(void* blob)
+{
+    free(blob);
+}
+
+// Measures the average time (in microseconds) to load, and dispose, the precompiled skeleton data.
+// The blob is written once, and copied before each load, since the pointers are relocated in place.
+// Returns a negative value if the blob couldn't be written or loaded.
+extern "C" DM_DLLEXPORT double SPINE_BenchmarkLoadBlob(void* spine_data, size_t spine_data_size, const char* path, void* atlas_buffer, size_t atlas_size, const char* atlas_path, int iterations)
+{
+    int blob_size = 0;
+    void* blob = SPINE_WriteSkeletonBlob(spine_data, spine_data_size, path, atlas_buffer, atlas_size, atlas_path, 0, &blob_size);
+    if (!blob)
+        return -1.0;
+
+    dmhash_t regions_hash = ((dmSpine::SkeletonBlobHeader*)blob)->m_RegionsHash;
+    void* copy = malloc(blob_size);
+
+    double result = 0.0;
+    uint64_t elapsed = 0;
+    for (int i = 0; i < iterations; ++i)
+    {
+        memcpy(copy, blob, blob_size);
+
+        uint64_t start = dmTime::GetMonotonicTime();
+        spSkeletonData* skeleton_data = dmSpine::LoadSkeletonBlob(copy, (uint32_t)blob_size, regions_hash);
+        if (!skeleton_data)
+        {
+            SPINE_SetLastError("Failed to load the precompiled skeleton");
+            result = -1.0;
+            break;
+        }
+        dmSpine::DisposeSkeletonBlob(skeleton_data);
+        elapsed += dmTime::GetMonotonicTime() - start;
+    }
+    if (result == 0.0 && iterations > 0)
+        result = elapsed / (double)iterations;
+
+    free(copy);
+    SPINE_FreeSkeletonBlob(blob);
+    return result;
+}
 
 extern "C" DM_DLLEXPORT void* SPINE_LoadFromPath(const char* path, const char* atlas_path) {
     size_t buffer_size = 0;
@@ -371,6 +508,8 @@ extern "C" DM_DLLEXPORT void SPINE_Destroy(void* _file) {
         spAnimationState_dispose(file->m_AnimationStateInstance);
     if (file->m_SkeletonInstance)
         spSkeleton_dispose(file->m_SkeletonInstance);
+    if (file->m_SkeletonClipper)
+        spSkeletonClipping_dispose(file->m_SkeletonClipper);
 
     if (file->m_AnimationStateData)
         spAnimationStateData_dispose(file->m_AnimationStateData);
@@ -492,6 +631,191 @@ extern "C" DM_DLLEXPORT void SPINE_UpdateVertices(void* _file, float dt, const f
     UpdateVertices(file, dt, ToMatrix4(world_transform), ToVector4(color_tint), use_index_buffer != 0);
 }
 
+struct UpdateVerticesJob
+{
+    SpineFile**     m_Files;
+    const float*    m_WorldTransforms;
+    const float*    m_ColorTints;
+    float           m_Dt;
+    uint32_t        m_Start;
+    uint32_t        m_End;
+    bool            m_UseIndexBuffer;
+};
+
+static void UpdateVerticesJobFunc(void* _job)
+{
+    UpdateVerticesJob* job = (UpdateVerticesJob*)_job;
+    for (uint32_t i = job->m_Start; i < job->m_End; ++i)
+    {
+        SpineFile* file = job->m_Files[i];
+        if (!file)
+            continue;
+        const float* transform = job->m_WorldTransforms ? job->m_WorldTransforms + i * 16 : 0;
+        const float* color_tint = job->m_ColorTints ? job->m_ColorTints + i * 4 : 0;
+        UpdateVertices(file, job->m_Dt, ToMatrix4(transform), ToVector4(color_tint), job->m_UseIndexBuffer);
+    }
+}
+
+// Worker threads for SPINE_UpdateVerticesMany. They are created on demand, and then stay
+// alive (waiting on m_WorkCond) until SPINE_ShutdownUpdateVertices, so that an update doesn't
+// pay for starting and joining threads.
+static const uint32_t UPDATE_VERTICES_MAX_THREADS = 16;
+
+struct UpdateVerticesPool
+{
+    dmMutex::HMutex                         m_CallMutex;    // Serializes the callers
+    dmMutex::HMutex                         m_Mutex;        // Guards the members below
+    dmConditionVariable::HConditionVariable m_WorkCond;
+    dmConditionVariable::HConditionVariable m_DoneCond;
+    dmThread::Thread                        m_Threads[UPDATE_VERTICES_MAX_THREADS];
+    UpdateVerticesJob                       m_Jobs[UPDATE_VERTICES_MAX_THREADS];
+    uint32_t                                m_ThreadCount;  // Number of started workers
+    uint32_t                                m_JobCount;     // Jobs in the current batch (job 0 runs on the caller)
+    uint32_t                                m_Pending;      // Worker jobs not yet finished
+    uint32_t                                m_Generation;   // Bumped for each batch
+    bool                                    m_Quit;         // Set to stop the workers
+};
+
+struct UpdateVerticesWorker
+{
+    UpdateVerticesPool* m_Pool;
+    uint32_t            m_Index;
+    uint32_t            m_Generation;   // The last batch seen by this worker
+};
+
+static UpdateVerticesWorker g_UpdateVerticesWorkers[UPDATE_VERTICES_MAX_THREADS];
+
+static void UpdateVerticesWorkerFunc(void* _worker)
+{
+    UpdateVerticesWorker* worker = (UpdateVerticesWorker*)_worker;
+    UpdateVerticesPool* pool = worker->m_Pool;
+
+    dmMutex::Lock(pool->m_Mutex);
+    while (true)
+    {
+        while (worker->m_Generation == pool->m_Generation && !pool->m_Quit)
+            dmConditionVariable::Wait(pool->m_WorkCond, pool->m_Mutex);
+        if (pool->m_Quit)
+            break;
+        worker->m_Generation = pool->m_Generation;
+
+        if (worker->m_Index >= pool->m_JobCount)
+            continue;
+
+        UpdateVerticesJob* job = &pool->m_Jobs[worker->m_Index];
+        dmMutex::Unlock(pool->m_Mutex);
+        UpdateVerticesJobFunc(job);
+        dmMutex::Lock(pool->m_Mutex);
+
+        if (--pool->m_Pending == 0)
+            dmConditionVariable::Signal(pool->m_DoneCond);
+    }
+    dmMutex::Unlock(pool->m_Mutex);
+}
+
+static UpdateVerticesPool* CreateUpdateVerticesPool()
+{
+    UpdateVerticesPool* pool = new UpdateVerticesPool;
+    memset(pool, 0, sizeof(*pool));
+    pool->m_CallMutex = dmMutex::New();
+    pool->m_Mutex = dmMutex::New();
+    pool->m_WorkCond = dmConditionVariable::New();
+    pool->m_DoneCond = dmConditionVariable::New();
+    return pool;
+}
+
+static UpdateVerticesPool* GetUpdateVerticesPool()
+{
+    // The editor may call in from more than one thread, and a function local static is only initialized once
+    static UpdateVerticesPool* pool = CreateUpdateVerticesPool();
+    return pool;
+}
+
+// Make sure there are at least (thread_count - 1) workers, as the caller runs one job itself.
+// Must be called with m_CallMutex held, as that keeps m_Generation from changing.
+static void EnsureUpdateVerticesWorkers(UpdateVerticesPool* pool, uint32_t thread_count)
+{
+    for (uint32_t i = pool->m_ThreadCount + 1; i < thread_count; ++i)
+    {
+        UpdateVerticesWorker* worker = &g_UpdateVerticesWorkers[i];
+        worker->m_Pool = pool;
+        worker->m_Index = i;
+        worker->m_Generation = pool->m_Generation; // Wait for the next batch
+        pool->m_Threads[i] = dmThread::New(UpdateVerticesWorkerFunc, 0x80000, worker, "SpineUpdateVertices");
+        pool->m_ThreadCount = i;
+    }
+}
+
+// Stops and joins the workers. They're started again by the next update that needs them.
+extern "C" DM_DLLEXPORT void SPINE_ShutdownUpdateVertices() {
+    UpdateVerticesPool* pool = GetUpdateVerticesPool();
+    DM_MUTEX_SCOPED_LOCK(pool->m_CallMutex);
+
+    dmMutex::Lock(pool->m_Mutex);
+    pool->m_Quit = true;
+    dmConditionVariable::Broadcast(pool->m_WorkCond);
+    dmMutex::Unlock(pool->m_Mutex);
+
+    for (uint32_t i = 1; i <= pool->m_ThreadCount; ++i)
+        dmThread::Join(pool->m_Threads[i]);
+    pool->m_ThreadCount = 0;
+    pool->m_Quit = false;
+}
+
+// Updates many files in one call. The transforms (16 floats each) and tints (4 floats each) are
+// laid out per file, and may be null. With num_threads > 1, the files are split into contiguous
+// ranges which are updated on a pool of worker threads (each file owns all state it touches).
+// A file may only be listed once, since it only holds the vertices of its last update.
+extern "C" DM_DLLEXPORT void SPINE_UpdateVerticesMany(void** _files, int count, float dt, const float* world_transforms, const float* color_tints, int use_index_buffer, int num_threads) {
+    if (!_files || count <= 0)
+        return;
+
+    uint32_t thread_count = (uint32_t)dmMath::Clamp(num_threads, 1, (int)UPDATE_VERTICES_MAX_THREADS);
+    thread_count = dmMath::Min(thread_count, (uint32_t)count);
+
+    UpdateVerticesJob jobs[UPDATE_VERTICES_MAX_THREADS];
+    uint32_t files_per_job = ((uint32_t)count + thread_count - 1) / thread_count;
+    for (uint32_t i = 0; i < thread_count; ++i)
+    {
+        UpdateVerticesJob& job = jobs[i];
+        job.m_Files = (SpineFile**)_files;
+        job.m_WorldTransforms = world_transforms;
+        job.m_ColorTints = color_tints;
+        job.m_Dt = dt;
+        job.m_Start = dmMath::Min(i * files_per_job, (uint32_t)count);
+        job.m_End = dmMath::Min(job.m_Start + files_per_job, (uint32_t)count);
+        job.m_UseIndexBuffer = use_index_buffer != 0;
+    }
+
+    if (thread_count == 1)
+    {
+        UpdateVerticesJobFunc(&jobs[0]);
+        return;
+    }
+
+    UpdateVerticesPool* pool = GetUpdateVerticesPool();
+    DM_MUTEX_SCOPED_LOCK(pool->m_CallMutex);
+
+    EnsureUpdateVerticesWorkers(pool, thread_count);
+
+    dmMutex::Lock(pool->m_Mutex);
+    for (uint32_t i = 1; i < thread_count; ++i)
+        pool->m_Jobs[i] = jobs[i];
+    pool->m_JobCount = thread_count;
+    pool->m_Pending = thread_count - 1;
+    pool->m_Generation++;
+    dmConditionVariable::Broadcast(pool->m_WorkCond);
+    dmMutex::Unlock(pool->m_Mutex);
+
+    // The calling thread takes the first range
+    UpdateVerticesJobFunc(&jobs[0]);
+
+    dmMutex::Lock(pool->m_Mutex);
+    while (pool->m_Pending > 0)
+        dmConditionVariable::Wait(pool->m_DoneCond, pool->m_Mutex);
+    dmMutex::Unlock(pool->m_Mutex);
+}
+
 static void UpdateVertices(SpineFile* file, float dt, const dmVMath::Matrix4& transform, const dmVMath::Vector4& color_tint, bool use_index_buffer)
 {
     if (!file || !file->m_AnimationStateInstance) {
@@ -742,7 +1066,9 @@ static void UpdateRenderData(SpineFile* file, const dmVMath::Matrix4& transform,
     file->m_VertexBuffer.SetSize(0);
     file->m_IndexBuffer.SetSize(0);
 
-    spSkeletonClipping* clipper = spSkeletonClipping_create();
+    if (!file->m_SkeletonClipper)
+        file->m_SkeletonClipper = spSkeletonClipping_create();
+    spSkeletonClipping* clipper = file->m_SkeletonClipper;
 
     uint32_t draw_desc_count = dmSpine::CalcDrawDescCount(file->m_SkeletonInstance);
 
@@ -757,27 +1083,14 @@ static void UpdateRenderData(SpineFile* file, const dmVMath::Matrix4& transform,
 
         dmSpine::GenerateIndexedVertexData(file->m_VertexBuffer, file->m_IndexBuffer, file->m_SkeletonInstance, clipper, transform, color_tint, &file->m_DrawDescScratch, file->m_GeometryScratch);
 
-        MergeIndexedDrawDescs(file->m_DrawDescScratch, file->m_MergedDrawDescScratch);
-
-        uint32_t merged_draw_desc_count = file->m_MergedDrawDescScratch.Size();
-        if (file->m_DrawDescs.Capacity() < merged_draw_desc_count)
-        {
-            uint32_t new_capacity = dmMath::Max(merged_draw_desc_count, dmMath::Max(16U, file->m_DrawDescs.Capacity() * 2));
-            file->m_DrawDescs.SetCapacity(new_capacity);
-        }
-        file->m_DrawDescs.SetSize(merged_draw_desc_count);
-        if (merged_draw_desc_count > 0)
-        {
-            memcpy(file->m_DrawDescs.Begin(), file->m_MergedDrawDescScratch.Begin(), merged_draw_desc_count * sizeof(dmSpine::SpineIndexedDrawDesc));
-        }
+        // Merges straight into the draw descs we hand out
+        MergeIndexedDrawDescs(file->m_DrawDescScratch, file->m_DrawDescs);
     }
     else
     {
-        dmSpine::GenerateVertexData(file->m_VertexBuffer, file->m_SkeletonInstance, clipper, transform, color_tint, 0);
+        dmSpine::GenerateVertexData(file->m_VertexBuffer, file->m_SkeletonInstance, clipper, transform, color_tint, 0, file->m_PositionScratch);
     }
 
     file->m_VertexBufferVersion++;
     file->m_IndexBufferVersion++;
-
-    spSkeletonClipping_dispose(clipper);
 }
@@ -0,0 +1,653 @@
+extern "C" {
+#include <spine/extension.h>
+#include <spine/SkeletonData.h>
+#include <spine/Skin.h>
+#include <spine/Sequence.h>
+#include <spine/EventData.h>
+#include <spine/Event.h>
+}
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dmsdk/dlib/array.h>
+#include <dmsdk/dlib/hashtable.h>
+#include <dmsdk/dlib/log.h>
+
+#include <common/spine_loader.h>
+
+#include "skeleton_blob.h"
+
+namespace dmSpine
+{
+    // Each object is copied once, keyed on its address, and written pointers are replaced with the offset of the copy.
+    // Since the buffer grows while writing, the copies are only referred to by offset.
+    struct SkeletonBlobWriter
+    {
+        dmArray<uint8_t>        m_Data;
+        dmHashTable64<uint32_t> m_Offsets;      // Source address to blob offset
+        dmArray<uint32_t>       m_Relocations;  // Offset of each written pointer
+        dmArray<uint32_t>       m_Attachments;
+        dmArray<uint32_t>       m_Timelines;
+        bool                    m_Error;
+    };
+
+    static void PushOffset(dmArray<uint32_t>& array, uint32_t offset)
+    {
+        if (array.Full())
+            array.OffsetCapacity(array.Capacity() + 256);
+        array.Push(offset);
+    }
+
+    template <typename T>
+    static T* At(SkeletonBlobWriter* writer, uint32_t offset)
+    {
+        return (T*)&writer->m_Data[offset];
+    }
+
+    // Returns the offset of zeroed, 8 byte aligned, memory
+    static uint32_t Allocate(SkeletonBlobWriter* writer, uint32_t size)
+    {
+        uint32_t offset = (writer->m_Data.Size() + 7) & ~7u;
+        uint32_t end = offset + (size ? size : 1);
+        if (end > writer->m_Data.Capacity())
+            writer->m_Data.SetCapacity(end > writer->m_Data.Capacity() * 2 ? end : writer->m_Data.Capacity() * 2);
+        uint32_t previous_size = writer->m_Data.Size();
+        writer->m_Data.SetSize(end);
+        memset(&writer->m_Data[previous_size], 0, end - previous_size);
+        return offset;
+    }
+
+    static uint32_t Find(SkeletonBlobWriter* writer, const void* source)
+    {
+        uint32_t* offset = writer->m_Offsets.Get((uint64_t)(uintptr_t)source);
+        return offset ? *offset : 0;
+    }
+
+    static uint32_t Copy(SkeletonBlobWriter* writer, const void* source, uint32_t size)
+    {
+        uint32_t offset = Allocate(writer, size);
+        if (size)
+            memcpy(At<uint8_t>(writer, offset), source, size);
+
+        if (writer->m_Offsets.Full())
+        {
+            uint32_t capacity = writer->m_Offsets.Capacity() * 2 + 1024;
+            writer->m_Offsets.SetCapacity(capacity/2+1, capacity);
+        }
+        writer->m_Offsets.Put((uint64_t)(uintptr_t)source, offset);
+        return offset;
+    }
+
+    // Stores the target offset in the pointer at pointer_offset. A target of 0 is a null pointer.
+    static void Link(SkeletonBlobWriter* writer, uint32_t pointer_offset, uint32_t target_offset)
+    {
+        *At<uintptr_t>(writer, pointer_offset) = target_offset;
+        if (target_offset)
+            PushOffset(writer->m_Relocations, pointer_offset);
+    }
+
+    static uint32_t WriteData(SkeletonBlobWriter* writer, const void* data, uint32_t size)
+    {
+        if (!data)
+            return 0;
+        uint32_t offset = Find(writer, data);
+        return offset ? offset : Copy(writer, data, size);
+    }
+
+    static uint32_t WriteString(SkeletonBlobWriter* writer, const char* string)
+    {
+        return string ? WriteData(writer, string, (uint32_t)strlen(string) + 1) : 0;
+    }
+
+    template <typename T>
+    static uint32_t WritePointers(SkeletonBlobWriter* writer, T* const* items, int count, uint32_t (*write)(SkeletonBlobWriter*, const T*))
+    {
+        if (!items)
+            return 0;
+        uint32_t offset = Find(writer, items);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, items, count * sizeof(T*));
+        for (int i = 0; i < count; ++i)
+            Link(writer, offset + i * sizeof(T*), write(writer, items[i]));
+        return offset;
+    }
+
+    // The spine arrays are all { int size; int capacity; T* items; }
+    template <typename ArrayType, typename T>
+    static uint32_t WritePointerArray(SkeletonBlobWriter* writer, const ArrayType* array, uint32_t (*write)(SkeletonBlobWriter*, const T*))
+    {
+        if (!array)
+            return 0;
+        uint32_t offset = Find(writer, array);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, array, sizeof(ArrayType));
+        At<ArrayType>(writer, offset)->capacity = array->size;
+        Link(writer, offset + offsetof(ArrayType, items), WritePointers(writer, array->items, array->size, write));
+        return offset;
+    }
+
+    template <typename ArrayType>
+    static uint32_t WriteValueArray(SkeletonBlobWriter* writer, const ArrayType* array)
+    {
+        if (!array)
+            return 0;
+        uint32_t offset = Find(writer, array);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, array, sizeof(ArrayType));
+        At<ArrayType>(writer, offset)->capacity = array->size;
+        Link(writer, offset + offsetof(ArrayType, items), WriteData(writer, array->items, array->size * sizeof(array->items[0])));
+        return offset;
+    }
+
+    static uint32_t WriteBoneData(SkeletonBlobWriter* writer, const spBoneData* bone)
+    {
+        if (!bone)
+            return 0;
+        uint32_t offset = Find(writer, bone);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, bone, sizeof(spBoneData));
+        Link(writer, offset + offsetof(spBoneData, name), WriteString(writer, bone->name));
+        Link(writer, offset + offsetof(spBoneData, parent), WriteBoneData(writer, bone->parent));
+        Link(writer, offset + offsetof(spBoneData, icon), WriteString(writer, bone->icon));
+        return offset;
+    }
+
+    static uint32_t WriteSlotData(SkeletonBlobWriter* writer, const spSlotData* slot)
+    {
+        if (!slot)
+            return 0;
+        uint32_t offset = Find(writer, slot);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, slot, sizeof(spSlotData));
+        Link(writer, offset + offsetof(spSlotData, name), WriteString(writer, slot->name));
+        Link(writer, offset + offsetof(spSlotData, boneData), WriteBoneData(writer, slot->boneData));
+        Link(writer, offset + offsetof(spSlotData, attachmentName), WriteString(writer, slot->attachmentName));
+        Link(writer, offset + offsetof(spSlotData, darkColor), WriteData(writer, slot->darkColor, sizeof(spColor)));
+        return offset;
+    }
+
+    static uint32_t WriteEventData(SkeletonBlobWriter* writer, const spEventData* event)
+    {
+        if (!event)
+            return 0;
+        uint32_t offset = Find(writer, event);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, event, sizeof(spEventData));
+        Link(writer, offset + offsetof(spEventData, name), WriteString(writer, event->name));
+        Link(writer, offset + offsetof(spEventData, stringValue), WriteString(writer, event->stringValue));
+        Link(writer, offset + offsetof(spEventData, audioPath), WriteString(writer, event->audioPath));
+        return offset;
+    }
+
+    static uint32_t WriteEvent(SkeletonBlobWriter* writer, const spEvent* event)
+    {
+        if (!event)
+            return 0;
+        uint32_t offset = Find(writer, event);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, event, sizeof(spEvent));
+        Link(writer, offset + offsetof(spEvent, data), WriteEventData(writer, event->data));
+        Link(writer, offset + offsetof(spEvent, stringValue), WriteString(writer, event->stringValue));
+        return offset;
+    }
+
+    static uint32_t WriteIkConstraintData(SkeletonBlobWriter* writer, const spIkConstraintData* constraint)
+    {
+        if (!constraint)
+            return 0;
+        uint32_t offset = Find(writer, constraint);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, constraint, sizeof(spIkConstraintData));
+        Link(writer, offset + offsetof(spIkConstraintData, name), WriteString(writer, constraint->name));
+        Link(writer, offset + offsetof(spIkConstraintData, bones), WritePointers(writer, constraint->bones, constraint->bonesCount, WriteBoneData));
+        Link(writer, offset + offsetof(spIkConstraintData, target), WriteBoneData(writer, constraint->target));
+        return offset;
+    }
+
+    static uint32_t WriteTransformConstraintData(SkeletonBlobWriter* writer, const spTransformConstraintData* constraint)
+    {
+        if (!constraint)
+            return 0;
+        uint32_t offset = Find(writer, constraint);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, constraint, sizeof(spTransformConstraintData));
+        Link(writer, offset + offsetof(spTransformConstraintData, name), WriteString(writer, constraint->name));
+        Link(writer, offset + offsetof(spTransformConstraintData, bones), WritePointers(writer, constraint->bones, constraint->bonesCount, WriteBoneData));
+        Link(writer, offset + offsetof(spTransformConstraintData, target), WriteBoneData(writer, constraint->target));
+        return offset;
+    }
+
+    static uint32_t WritePathConstraintData(SkeletonBlobWriter* writer, const spPathConstraintData* constraint)
+    {
+        if (!constraint)
+            return 0;
+        uint32_t offset = Find(writer, constraint);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, constraint, sizeof(spPathConstraintData));
+        Link(writer, offset + offsetof(spPathConstraintData, name), WriteString(writer, constraint->name));
+        Link(writer, offset + offsetof(spPathConstraintData, bones), WritePointers(writer, constraint->bones, constraint->bonesCount, WriteBoneData));
+        Link(writer, offset + offsetof(spPathConstraintData, target), WriteSlotData(writer, constraint->target));
+        return offset;
+    }
+
+    static uint32_t WritePhysicsConstraintData(SkeletonBlobWriter* writer, const spPhysicsConstraintData* constraint)
+    {
+        if (!constraint)
+            return 0;
+        uint32_t offset = Find(writer, constraint);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, constraint, sizeof(spPhysicsConstraintData));
+        Link(writer, offset + offsetof(spPhysicsConstraintData, name), WriteString(writer, constraint->name));
+        Link(writer, offset + offsetof(spPhysicsConstraintData, bone), WriteBoneData(writer, constraint->bone));
+        return offset;
+    }
+
+    // The regions are created by CreateRegions(), and only the texture region part and the page index are used
+    static uint32_t WriteRegion(SkeletonBlobWriter* writer, const spTextureRegion* region)
+    {
+        if (!region)
+            return 0;
+        uint32_t offset = Find(writer, region);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, region, sizeof(spAtlasRegion));
+        spAtlasRegion* atlas_region = At<spAtlasRegion>(writer, offset);
+        atlas_region->name = 0;
+        atlas_region->splits = 0;
+        atlas_region->pads = 0;
+        atlas_region->keyValues = 0;
+        atlas_region->page = 0;
+        atlas_region->next = 0;
+        Link(writer, offset + offsetof(spAtlasRegion, super.rendererObject), region->rendererObject == region ? offset : 0);
+        return offset;
+    }
+
+    static uint32_t WriteSequence(SkeletonBlobWriter* writer, const spSequence* sequence)
+    {
+        if (!sequence)
+            return 0;
+        uint32_t offset = Find(writer, sequence);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, sequence, sizeof(spSequence));
+        Link(writer, offset + offsetof(spSequence, regions), WritePointerArray(writer, sequence->regions, WriteRegion));
+        return offset;
+    }
+
+    static uint32_t GetAttachmentSize(spAttachmentType type)
+    {
+        switch (type)
+        {
+        case SP_ATTACHMENT_REGION:          return sizeof(spRegionAttachment);
+        case SP_ATTACHMENT_BOUNDING_BOX:    return sizeof(spBoundingBoxAttachment);
+        case SP_ATTACHMENT_MESH:
+        case SP_ATTACHMENT_LINKED_MESH:     return sizeof(spMeshAttachment);
+        case SP_ATTACHMENT_PATH:            return sizeof(spPathAttachment);
+        case SP_ATTACHMENT_POINT:           return sizeof(spPointAttachment);
+        case SP_ATTACHMENT_CLIPPING:        return sizeof(spClippingAttachment);
+        default:                            return 0;
+        }
+    }
+
+    static uint32_t WriteAttachment(SkeletonBlobWriter* writer, const spAttachment* attachment);
+
+    static void WriteVertexAttachment(SkeletonBlobWriter* writer, uint32_t offset, const spVertexAttachment* attachment)
+    {
+        Link(writer, offset + offsetof(spVertexAttachment, bones), WriteData(writer, attachment->bones, attachment->bonesCount * sizeof(int)));
+        Link(writer, offset + offsetof(spVertexAttachment, vertices), WriteData(writer, attachment->vertices, attachment->verticesCount * sizeof(float)));
+        Link(writer, offset + offsetof(spVertexAttachment, timelineAttachment), WriteAttachment(writer, attachment->timelineAttachment));
+    }
+
+    static uint32_t WriteAttachment(SkeletonBlobWriter* writer, const spAttachment* attachment)
+    {
+        if (!attachment)
+            return 0;
+        uint32_t offset = Find(writer, attachment);
+        if (offset)
+            return offset;
+
+        uint32_t size = GetAttachmentSize(attachment->type);
+        if (!size)
+        {
+            dmLogError("Can't write attachment '%s' of unknown type %d", attachment->name, attachment->type);
+            writer->m_Error = true;
+            return 0;
+        }
+
+        // The vtable is set by the loader
+        offset = Copy(writer, attachment, size);
+        At<spAttachment>(writer, offset)->vtable = 0;
+        At<spAttachment>(writer, offset)->attachmentLoader = 0;
+        PushOffset(writer->m_Attachments, offset);
+        Link(writer, offset + offsetof(spAttachment, name), WriteString(writer, attachment->name));
+
+        switch (attachment->type)
+        {
+        case SP_ATTACHMENT_REGION:
+            {
+                const spRegionAttachment* region = (const spRegionAttachment*)attachment;
+                Link(writer, offset + offsetof(spRegionAttachment, path), WriteString(writer, region->path));
+                Link(writer, offset + offsetof(spRegionAttachment, rendererObject), WriteRegion(writer, (const spTextureRegion*)region->rendererObject));
+                Link(writer, offset + offsetof(spRegionAttachment, region), WriteRegion(writer, region->region));
+                Link(writer, offset + offsetof(spRegionAttachment, sequence), WriteSequence(writer, region->sequence));
+            }
+            break;
+        case SP_ATTACHMENT_MESH:
+        case SP_ATTACHMENT_LINKED_MESH:
+            {
+                const spMeshAttachment* mesh = (const spMeshAttachment*)attachment;
+                int vertices_length = mesh->super.worldVerticesLength;
+                WriteVertexAttachment(writer, offset, &mesh->super);
+                Link(writer, offset + offsetof(spMeshAttachment, rendererObject), WriteRegion(writer, (const spTextureRegion*)mesh->rendererObject));
+                Link(writer, offset + offsetof(spMeshAttachment, region), WriteRegion(writer, mesh->region));
+                Link(writer, offset + offsetof(spMeshAttachment, sequence), WriteSequence(writer, mesh->sequence));
+                Link(writer, offset + offsetof(spMeshAttachment, path), WriteString(writer, mesh->path));
+                Link(writer, offset + offsetof(spMeshAttachment, regionUVs), WriteData(writer, mesh->regionUVs, vertices_length * sizeof(float)));
+                // Sequence meshes get their uvs when the first frame is applied (see spMeshAttachment_updateRegion)
+                uint32_t uvs = mesh->uvs ? WriteData(writer, mesh->uvs, vertices_length * sizeof(float)) : Allocate(writer, vertices_length * sizeof(float));
+                Link(writer, offset + offsetof(spMeshAttachment, uvs), uvs);
+                Link(writer, offset + offsetof(spMeshAttachment, triangles), WriteData(writer, mesh->triangles, mesh->trianglesCount * sizeof(unsigned short)));
+                Link(writer, offset + offsetof(spMeshAttachment, parentMesh), WriteAttachment(writer, (const spAttachment*)mesh->parentMesh));
+                Link(writer, offset + offsetof(spMeshAttachment, edges), WriteData(writer, mesh->edges, mesh->edgesCount * sizeof(unsigned short)));
+            }
+            break;
+        case SP_ATTACHMENT_BOUNDING_BOX:
+            WriteVertexAttachment(writer, offset, (const spVertexAttachment*)attachment);
+            break;
+        case SP_ATTACHMENT_PATH:
+            {
+                const spPathAttachment* path = (const spPathAttachment*)attachment;
+                WriteVertexAttachment(writer, offset, &path->super);
+                Link(writer, offset + offsetof(spPathAttachment, lengths), WriteData(writer, path->lengths, path->lengthsLength * sizeof(float)));
+            }
+            break;
+        case SP_ATTACHMENT_CLIPPING:
+            {
+                const spClippingAttachment* clipping = (const spClippingAttachment*)attachment;
+                WriteVertexAttachment(writer, offset, &clipping->super);
+                Link(writer, offset + offsetof(spClippingAttachment, endSlot), WriteSlotData(writer, clipping->endSlot));
+            }
+            break;
+        default:
+            break;
+        }
+        return offset;
+    }
+
+    // The loader creates new skins from the entries list, so the lookup table isn't written
+    static uint32_t WriteSkin(SkeletonBlobWriter* writer, const spSkin* skin)
+    {
+        if (!skin)
+            return 0;
+        uint32_t offset = Find(writer, skin);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, skin, sizeof(_spSkin));
+        memset(At<_spSkin>(writer, offset)->entriesHashTable, 0, sizeof(((_spSkin*)0)->entriesHashTable));
+        Link(writer, offset + offsetof(spSkin, name), WriteString(writer, skin->name));
+        Link(writer, offset + offsetof(spSkin, bones), WritePointerArray(writer, skin->bones, WriteBoneData));
+        Link(writer, offset + offsetof(spSkin, ikConstraints), WritePointerArray(writer, skin->ikConstraints, WriteIkConstraintData));
+        Link(writer, offset + offsetof(spSkin, transformConstraints), WritePointerArray(writer, skin->transformConstraints, WriteTransformConstraintData));
+        Link(writer, offset + offsetof(spSkin, pathConstraints), WritePointerArray(writer, skin->pathConstraints, WritePathConstraintData));
+        Link(writer, offset + offsetof(spSkin, physicsConstraints), WritePointerArray(writer, skin->physicsConstraints, WritePhysicsConstraintData));
+
+        uint32_t next_offset = offset + offsetof(_spSkin, entries);
+        for (const spSkinEntry* entry = spSkin_getAttachments(skin); entry; entry = entry->next)
+        {
+            uint32_t entry_offset = Copy(writer, entry, sizeof(spSkinEntry));
+            Link(writer, next_offset, entry_offset);
+            Link(writer, entry_offset + offsetof(spSkinEntry, name), WriteString(writer, entry->name));
+            Link(writer, entry_offset + offsetof(spSkinEntry, attachment), WriteAttachment(writer, entry->attachment));
+            next_offset = entry_offset + offsetof(spSkinEntry, next);
+        }
+        Link(writer, next_offset, 0);
+        return offset;
+    }
+
+    static uint32_t GetTimelineSize(spTimelineType type)
+    {
+        switch (type)
+        {
+        case SP_TIMELINE_ATTACHMENT:                    return sizeof(spAttachmentTimeline);
+        case SP_TIMELINE_ALPHA:                         return sizeof(spAlphaTimeline);
+        case SP_TIMELINE_PATHCONSTRAINTPOSITION:        return sizeof(spPathConstraintPositionTimeline);
+        case SP_TIMELINE_PATHCONSTRAINTSPACING:         return sizeof(spPathConstraintSpacingTimeline);
+        case SP_TIMELINE_ROTATE:                        return sizeof(spRotateTimeline);
+        case SP_TIMELINE_SCALEX:                        return sizeof(spScaleXTimeline);
+        case SP_TIMELINE_SCALEY:                        return sizeof(spScaleYTimeline);
+        case SP_TIMELINE_SHEARX:                        return sizeof(spShearXTimeline);
+        case SP_TIMELINE_SHEARY:                        return sizeof(spShearYTimeline);
+        case SP_TIMELINE_TRANSLATEX:                    return sizeof(spTranslateXTimeline);
+        case SP_TIMELINE_TRANSLATEY:                    return sizeof(spTranslateYTimeline);
+        case SP_TIMELINE_SCALE:                         return sizeof(spScaleTimeline);
+        case SP_TIMELINE_SHEAR:                         return sizeof(spShearTimeline);
+        case SP_TIMELINE_TRANSLATE:                     return sizeof(spTranslateTimeline);
+        case SP_TIMELINE_DEFORM:                        return sizeof(spDeformTimeline);
+        case SP_TIMELINE_SEQUENCE:                      return sizeof(spSequenceTimeline);
+        case SP_TIMELINE_INHERIT:                       return sizeof(spInheritTimeline);
+        case SP_TIMELINE_IKCONSTRAINT:                  return sizeof(spIkConstraintTimeline);
+        case SP_TIMELINE_PATHCONSTRAINTMIX:             return sizeof(spPathConstraintMixTimeline);
+        case SP_TIMELINE_PHYSICSCONSTRAINT_INERTIA:
+        case SP_TIMELINE_PHYSICSCONSTRAINT_STRENGTH:
+        case SP_TIMELINE_PHYSICSCONSTRAINT_DAMPING:
+        case SP_TIMELINE_PHYSICSCONSTRAINT_MASS:
+        case SP_TIMELINE_PHYSICSCONSTRAINT_WIND:
+        case SP_TIMELINE_PHYSICSCONSTRAINT_GRAVITY:
+        case SP_TIMELINE_PHYSICSCONSTRAINT_MIX:         return sizeof(spPhysicsConstraintTimeline);
+        case SP_TIMELINE_PHYSICSCONSTRAINT_RESET:       return sizeof(spPhysicsConstraintResetTimeline);
+        case SP_TIMELINE_RGB2:                          return sizeof(spRGB2Timeline);
+        case SP_TIMELINE_RGBA2:                         return sizeof(spRGBA2Timeline);
+        case SP_TIMELINE_RGBA:                          return sizeof(spRGBATimeline);
+        case SP_TIMELINE_RGB:                           return sizeof(spRGBTimeline);
+        case SP_TIMELINE_TRANSFORMCONSTRAINT:           return sizeof(spTransformConstraintTimeline);
+        case SP_TIMELINE_DRAWORDER:                     return sizeof(spDrawOrderTimeline);
+        case SP_TIMELINE_EVENT:                         return sizeof(spEventTimeline);
+        default:                                        return 0;
+        }
+    }
+
+    static bool IsCurveTimeline(spTimelineType type)
+    {
+        switch (type)
+        {
+        case SP_TIMELINE_ATTACHMENT:
+        case SP_TIMELINE_SEQUENCE:
+        case SP_TIMELINE_INHERIT:
+        case SP_TIMELINE_PHYSICSCONSTRAINT_RESET:
+        case SP_TIMELINE_DRAWORDER:
+        case SP_TIMELINE_EVENT:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    // An array of frameCount pointers to count values each, where a pointer may be null
+    static uint32_t WriteFrameArrays(SkeletonBlobWriter* writer, const void* const* frames, int frame_count, uint32_t frame_size)
+    {
+        if (!frames)
+            return 0;
+        uint32_t offset = Copy(writer, frames, frame_count * sizeof(void*));
+        for (int i = 0; i < frame_count; ++i)
+            Link(writer, offset + i * sizeof(void*), WriteData(writer, frames[i], frame_size));
+        return offset;
+    }
+
+    static uint32_t WriteTimeline(SkeletonBlobWriter* writer, const spTimeline* timeline)
+    {
+        if (!timeline)
+            return 0;
+        uint32_t offset = Find(writer, timeline);
+        if (offset)
+            return offset;
+
+        uint32_t size = GetTimelineSize(timeline->type);
+        if (!size)
+        {
+            dmLogError("Can't write timeline of unknown type %d", timeline->type);
+            writer->m_Error = true;
+            return 0;
+        }
+
+        // The vtable is set by the loader
+        offset = Copy(writer, timeline, size);
+        memset(&At<spTimeline>(writer, offset)->vtable, 0, sizeof(_spTimelineVtable));
+        PushOffset(writer->m_Timelines, offset);
+        Link(writer, offset + offsetof(spTimeline, frames), WriteValueArray(writer, timeline->frames));
+        if (IsCurveTimeline(timeline->type))
+            Link(writer, offset + offsetof(spCurveTimeline, curves), WriteValueArray(writer, ((const spCurveTimeline*)timeline)->curves));
+
+        switch (timeline->type)
+        {
+        case SP_TIMELINE_ATTACHMENT:
+            {
+                const spAttachmentTimeline* attachment_timeline = (const spAttachmentTimeline*)timeline;
+                Link(writer, offset + offsetof(spAttachmentTimeline, attachmentNames),
+                        WritePointers(writer, attachment_timeline->attachmentNames, timeline->frameCount, WriteString));
+            }
+            break;
+        case SP_TIMELINE_DEFORM:
+            {
+                const spDeformTimeline* deform = (const spDeformTimeline*)timeline;
+                Link(writer, offset + offsetof(spDeformTimeline, frameVertices),
+                        WriteFrameArrays(writer, (const void* const*)deform->frameVertices, timeline->frameCount, deform->frameVerticesCount * sizeof(float)));
+                Link(writer, offset + offsetof(spDeformTimeline, attachment), WriteAttachment(writer, deform->attachment));
+            }
+            break;
+        case SP_TIMELINE_SEQUENCE:
+            {
+                const spSequenceTimeline* sequence = (const spSequenceTimeline*)timeline;
+                Link(writer, offset + offsetof(spSequenceTimeline, attachment), WriteAttachment(writer, sequence->attachment));
+            }
+            break;
+        case SP_TIMELINE_EVENT:
+            {
+                const spEventTimeline* event_timeline = (const spEventTimeline*)timeline;
+                Link(writer, offset + offsetof(spEventTimeline, events), WritePointers(writer, event_timeline->events, timeline->frameCount, WriteEvent));
+            }
+            break;
+        case SP_TIMELINE_DRAWORDER:
+            {
+                const spDrawOrderTimeline* draw_order = (const spDrawOrderTimeline*)timeline;
+                Link(writer, offset + offsetof(spDrawOrderTimeline, drawOrders),
+                        WriteFrameArrays(writer, (const void* const*)draw_order->drawOrders, timeline->frameCount, draw_order->slotsCount * sizeof(int)));
+            }
+            break;
+        default:
+            break;
+        }
+        return offset;
+    }
+
+    static uint32_t WriteAnimation(SkeletonBlobWriter* writer, const spAnimation* animation)
+    {
+        if (!animation)
+            return 0;
+        uint32_t offset = Find(writer, animation);
+        if (offset)
+            return offset;
+
+        offset = Copy(writer, animation, sizeof(spAnimation));
+        Link(writer, offset + offsetof(spAnimation, name), WriteString(writer, animation->name));
+        Link(writer, offset + offsetof(spAnimation, timelines), WritePointerArray(writer, animation->timelines, WriteTimeline));
+        Link(writer, offset + offsetof(spAnimation, timelineIds), WriteValueArray(writer, animation->timelineIds));
+        return offset;
+    }
+
+    static uint32_t WriteSkeletonData(SkeletonBlobWriter* writer, const spSkeletonData* data)
+    {
+        uint32_t offset = Copy(writer, data, sizeof(spSkeletonData));
+        Link(writer, offset + offsetof(spSkeletonData, version), WriteString(writer, data->version));
+        Link(writer, offset + offsetof(spSkeletonData, hash), WriteString(writer, data->hash));
+        Link(writer, offset + offsetof(spSkeletonData, imagesPath), WriteString(writer, data->imagesPath));
+        Link(writer, offset + offsetof(spSkeletonData, audioPath), WriteString(writer, data->audioPath));
+        Link(writer, offset + offsetof(spSkeletonData, strings), WritePointers(writer, data->strings, data->stringsCount, WriteString));
+        Link(writer, offset + offsetof(spSkeletonData, bones), WritePointers(writer, data->bones, data->bonesCount, WriteBoneData));
+        Link(writer, offset + offsetof(spSkeletonData, slots), WritePointers(writer, data->slots, data->slotsCount, WriteSlotData));
+        Link(writer, offset + offsetof(spSkeletonData, skins), WritePointers(writer, data->skins, data->skinsCount, WriteSkin));
+        Link(writer, offset + offsetof(spSkeletonData, defaultSkin), WriteSkin(writer, data->defaultSkin));
+        Link(writer, offset + offsetof(spSkeletonData, events), WritePointers(writer, data->events, data->eventsCount, WriteEventData));
+        Link(writer, offset + offsetof(spSkeletonData, animations), WritePointers(writer, data->animations, data->animationsCount, WriteAnimation));
+        Link(writer, offset + offsetof(spSkeletonData, ikConstraints),
+                WritePointers(writer, data->ikConstraints, data->ikConstraintsCount, WriteIkConstraintData));
+        Link(writer, offset + offsetof(spSkeletonData, transformConstraints),
+                WritePointers(writer, data->transformConstraints, data->transformConstraintsCount, WriteTransformConstraintData));
+        Link(writer, offset + offsetof(spSkeletonData, pathConstraints),
+                WritePointers(writer, data->pathConstraints, data->pathConstraintsCount, WritePathConstraintData));
+        Link(writer, offset + offsetof(spSkeletonData, physicsConstraints),
+                WritePointers(writer, data->physicsConstraints, data->physicsConstraintsCount, WritePhysicsConstraintData));
+        return offset;
+    }
+
+    static uint32_t WriteOffsets(SkeletonBlobWriter* writer, const dmArray<uint32_t>& offsets)
+    {
+        uint32_t offset = Allocate(writer, offsets.Size() * sizeof(uint32_t));
+        if (!offsets.Empty())
+            memcpy(At<uint8_t>(writer, offset), offsets.Begin(), offsets.Size() * sizeof(uint32_t));
+        return offset;
+    }
+
+    void* WriteSkeletonBlob(spSkeletonData* skeleton_data, dmhash_t regions_hash, uint32_t* out_size)
+    {
+        SkeletonBlobWriter writer;
+        writer.m_Error = false;
+
+        // Offset 0 is the header, so no written object can be mistaken for a null pointer
+        uint32_t header_offset = Allocate(&writer, sizeof(SkeletonBlobHeader));
+        uint32_t skeleton_data_offset = WriteSkeletonData(&writer, skeleton_data);
+        if (writer.m_Error)
+            return 0;
+
+        uint32_t relocations = WriteOffsets(&writer, writer.m_Relocations);
+        uint32_t attachments = WriteOffsets(&writer, writer.m_Attachments);
+        uint32_t timelines = WriteOffsets(&writer, writer.m_Timelines);
+
+        SkeletonBlobHeader* header = At<SkeletonBlobHeader>(&writer, header_offset);
+        header->m_Magic = SKELETON_BLOB_MAGIC;
+        header->m_Version = SKELETON_BLOB_VERSION;
+        header->m_LayoutHash = GetSkeletonBlobLayoutHash();
+        header->m_RegionsHash = regions_hash;
+        header->m_Size = writer.m_Data.Size();
+        header->m_Loaded = 0;
+        header->m_SkeletonData = skeleton_data_offset;
+        header->m_Relocations = relocations;
+        header->m_RelocationCount = writer.m_Relocations.Size();
+        header->m_Attachments = attachments;
+        header->m_AttachmentCount = writer.m_Attachments.Size();
+        header->m_Timelines = timelines;
+        header->m_TimelineCount = writer.m_Timelines.Size();
+        header->m_Reserved = 0;
+
+        void* blob = malloc(writer.m_Data.Size());
+        memcpy(blob, writer.m_Data.Begin(), writer.m_Data.Size());
+        *out_size = writer.m_Data.Size();
+        return blob;
+    }
+}
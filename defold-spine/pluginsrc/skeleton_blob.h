@@ -0,0 +1,18 @@
+#ifndef DM_SPINE_SKELETON_BLOB_H
+#define DM_SPINE_SKELETON_BLOB_H
+
+#include <stdint.h>
+
+#include <dmsdk/dlib/hash.h>
+
+struct spSkeletonData;
+
+namespace dmSpine
+{
+    // Writes the skeleton data in the format read by LoadSkeletonBlob() (see common/spine_loader.h).
+    // The attachments must have been created with the atlas that regions_hash was calculated from.
+    // Returns a malloc'ed buffer, or 0 if the skeleton data can't be written.
+    void* WriteSkeletonBlob(spSkeletonData* skeleton_data, dmhash_t regions_hash, uint32_t* out_size);
+}
+
+#endif // DM_SPINE_SKELETON_BLOB_H
@@ -30,6 +30,8 @@ extern "C" {
 } // extern C
 
 #include <string.h> // memset
+#include <float.h> // FLT_MAX
+#include <algorithm> // std::sort
 
 #include <dmsdk/script.h>
 #include <dmsdk/dlib/array.h>
@@ -58,6 +60,15 @@ DM_PROPERTY_U32(rmtp_SpineComponents, 0, PROFILE_PROPERTY_FRAME_RESET, "# spine
 DM_PROPERTY_U32(rmtp_SpineVertexCount, 0, PROFILE_PROPERTY_FRAME_RESET, "# vertices", &rmtp_Spine);
 DM_PROPERTY_U32(rmtp_SpineVertexSize, 0, PROFILE_PROPERTY_FRAME_RESET, "size of vertices in bytes", &rmtp_Spine);
 DM_PROPERTY_U32(rmtp_SpineIndexSize, 0, PROFILE_PROPERTY_FRAME_RESET, "size of indices in bytes", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineRenderObjects, 0, PROFILE_PROPERTY_FRAME_RESET, "# render objects in use", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineRenderObjectsPeak, 0, PROFILE_PROPERTY_NONE, "peak # render objects in use in a world", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineRenderObjectOverflows, 0, PROFILE_PROPERTY_FRAME_RESET, "# render object overflow blocks allocated", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineBatches, 0, PROFILE_PROPERTY_FRAME_RESET, "# batches", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineBatchBreakMaterial, 0, PROFILE_PROPERTY_FRAME_RESET, "# batch breaks due to material", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineBatchBreakTexture, 0, PROFILE_PROPERTY_FRAME_RESET, "# batch breaks due to texture", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineBatchBreakBlendMode, 0, PROFILE_PROPERTY_FRAME_RESET, "# batch breaks due to blend mode", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineBatchBreakConstants, 0, PROFILE_PROPERTY_FRAME_RESET, "# batch breaks due to render constants", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineBatchBreakOrder, 0, PROFILE_PROPERTY_FRAME_RESET, "# batch breaks due to draw order", &rmtp_Spine);
 
 namespace dmSpine
 {
@@ -77,10 +88,28 @@ namespace dmSpine
     static const uint32_t RENDER_OBJECT_OVERFLOW_BLOCK_SIZE = 1U << RENDER_OBJECT_OVERFLOW_BLOCK_SHIFT;
     static const uint32_t RENDER_OBJECT_OVERFLOW_BLOCK_MASK = RENDER_OBJECT_OVERFLOW_BLOCK_SIZE - 1;
 
+    // The highest number of render objects used by any world, for the rmtp_SpineRenderObjectsPeak property
+    static uint32_t g_RenderObjectsPeak = 0;
+
     static void ResourceReloadedCallback(const dmResource::ResourceReloadedParams* params);
     static void DestroyComponent(struct SpineModelWorld* world, uint32_t index);
     static void SpineEventListener(spAnimationState* state, spEventType type, spTrackEntry* entry, spEvent* event);
 
+    // The state that decided the previous batch, used to attribute why a new batch was started
+    struct SpineBatchKey
+    {
+        dmRender::HMaterial                         m_Material;
+        dmGraphics::HTexture                        m_Texture;
+        dmGameSystemDDF::SpineModelDesc::BlendMode  m_BlendMode;
+        uint32_t                                    m_MixedHash;
+    };
+
+    struct SpineReorderBucket
+    {
+        uint32_t m_DescOffset;
+        uint32_t m_IndexOffset;
+    };
+
     struct SpineModelWorld
     {
         dmObjectPool<SpineModelComponent*>      m_Components;
@@ -96,10 +125,17 @@ namespace dmSpine
         dmArray<uint8_t>                        m_PackedIndexBufferData;
         dmArray<SpineIndexedDrawDesc>           m_DrawDescBuffer;
         dmArray<SpineIndexedDrawDesc>           m_MergedDrawDescBuffer;
+        dmArray<SpineIndexedDrawDesc>           m_SortedDrawDescBuffer;
+        dmArray<uint32_t>                       m_DrawDescKeys;
+        dmArray<SpineReorderBucket>             m_ReorderBuckets;
+        dmArray<uint32_t>                       m_ReorderIndexScratch;
+        dmArray<dmSpine::SpineModelBounds>      m_BatchBounds;
         dmResource::HFactory                    m_Factory;
         spSkeletonClipping*                     m_SkeletonClipper;
+        SpineBatchKey                           m_PreviousBatchKey;
         uint32_t                                m_RenderObjectsInUse;
         uint8_t                                 m_Is16BitIndex : 1;
+        uint8_t                                 m_HasPreviousBatch : 1;
     };
 
     struct SpineModelContext
@@ -112,6 +148,7 @@ namespace dmSpine
         dmRender::HRenderContext    m_RenderContext;
         dmGraphics::HContext        m_GraphicsContext;
         uint32_t                    m_MaxSpineModelCount;
+        uint32_t                    m_MaxRenderObjectCount;
     };
 
     dmGameObject::CreateResult CompSpineModelNewWorld(const dmGameObject::ComponentNewWorldParams& params)
@@ -127,10 +164,12 @@ namespace dmSpine
         // The common case produces at most one render object per component.
         // Reserving that storage before rendering keeps it contiguous and means
         // it cannot move after AddToRender has retained pointers into it.
-        world->m_RenderObjects.SetCapacity(comp_count);
+        // Inherited blend modes need more, which can be reserved with "spine.max_render_objects".
+        world->m_RenderObjects.SetCapacity(dmMath::Max(comp_count, context->m_MaxRenderObjectCount));
         world->m_BoundingBoxes.SetCapacity(comp_count);
         world->m_BoundingBoxes.SetSize(comp_count);
         world->m_RenderObjectsInUse = 0;
+        world->m_HasPreviousBatch = 0;
 
         dmGraphics::HVertexStreamDeclaration stream_declaration = dmGraphics::NewVertexStreamDeclaration(context->m_GraphicsContext);
         dmGraphics::AddVertexStream(stream_declaration, "position", 3, dmGraphics::TYPE_FLOAT, false);
@@ -184,21 +223,27 @@ namespace dmSpine
     static inline SpineSceneResource* GetSpineScene(const SpineModelComponent* component) {
         return component->m_SpineScene ? component->m_SpineScene : component->m_Resource->m_SpineScene;
     }
+    static inline dmGraphics::HTexture GetTexture(const SpineModelComponent* component) {
+        return GetSpineScene(component)->m_TextureSet->m_Texture->m_Texture; // spine - texture set resource - texture resource - texture
+    }
 
     static void ReHash(SpineModelComponent* component)
     {
-        // material, texture set, blend mode and render constants
+        // material, texture, blend mode and render constants
+        // We hash the GPU texture rather than the spine scene or texture set resource, so that
+        // components from different spine scenes sharing the same atlas texture can batch together
         HashState32 state;
         bool reverse = false;
         SpineModelResource* resource = component->m_Resource;
         dmGameSystemDDF::SpineModelDesc* ddf = resource->m_Ddf;
         dmRender::HMaterial material = GetMaterial(component);
 
-        dmGameSystem::TextureSetResource* texture_set = GetSpineScene(component)->m_TextureSet;
+        dmGraphics::HTexture texture = GetTexture(component);
         dmHashInit32(&state, reverse);
         dmHashUpdateBuffer32(&state, &material, sizeof(material));
-        dmHashUpdateBuffer32(&state, &texture_set, sizeof(texture_set));
+        dmHashUpdateBuffer32(&state, &texture, sizeof(texture));
         dmHashUpdateBuffer32(&state, &ddf->m_BlendMode, sizeof(ddf->m_BlendMode));
+        dmHashUpdateBuffer32(&state, &ddf->m_BlendReorder, sizeof(ddf->m_BlendReorder));
         if (component->m_RenderConstants)
             dmGameSystem::HashRenderConstants(component->m_RenderConstants, &state);
         component->m_MixedHash = dmHashFinal32(&state);
@@ -222,7 +267,22 @@ namespace dmSpine
         dmGameObject::SetScale(instance, transform.GetScale());
     }
 
-    static bool CreateGOBone(SpineModelComponent* component, dmGameObject::HCollection collection, dmGameObject::HInstance goparent, spBone* parent, spBone* bone, int indent)
+    // Writes the bone transform to its game object, if it changed since the last write.
+    // Returns true if the game object was updated
+    static bool WriteBoneTransform(SpineModelComponent* component, uint32_t index, bool force)
+    {
+        const spBone* bone = component->m_Bones[index];
+        BoneInstanceState& state = component->m_BoneStates[index];
+        const float matrix[6] = { bone->a, bone->b, bone->c, bone->d, bone->worldX, bone->worldY };
+        if (!force && memcmp(state.m_Matrix, matrix, sizeof(matrix)) == 0)
+            return false;
+
+        memcpy(state.m_Matrix, matrix, sizeof(matrix));
+        SetTransformFromBone(component->m_BoneInstances[index], component->m_Transform, bone);
+        return true;
+    }
+
+    static bool CreateGOBoneInstance(SpineModelComponent* component, dmGameObject::HCollection collection, dmGameObject::HInstance goparent, spBone* bone, dmhash_t name_hash)
     {
         dmGameObject::HInstance bone_instance = dmGameObject::New(collection, 0x0);
         if (!bone_instance)
@@ -251,13 +311,21 @@ namespace dmSpine
             return false;
         }
 
-        SetTransformFromBone(bone_instance, component->m_Transform, bone);
-
-        dmhash_t name_hash = dmHashString64(bone->data->name);
         component->m_BoneNameToNodeInstanceIndex.Put(name_hash, component->m_BoneInstances.Size());
 
+        BoneInstanceState state;
+        state.m_Active = 0;
         component->m_BoneInstances.Push(bone_instance);
         component->m_Bones.Push(bone);
+        component->m_BoneStates.Push(state);
+        WriteBoneTransform(component, component->m_BoneInstances.Size() - 1, true);
+        return true;
+    }
+
+    static bool CreateGOBone(SpineModelComponent* component, dmGameObject::HCollection collection, dmGameObject::HInstance goparent, spBone* parent, spBone* bone, int indent)
+    {
+        if (!CreateGOBoneInstance(component, collection, goparent, bone, dmHashString64(bone->data->name)))
+            return false;
 
         // Create the children
         for (int n = 0; n < bone->childrenCount; ++n)
@@ -274,8 +342,6 @@ namespace dmSpine
 
     static bool CreateGOBones(SpineModelWorld* world, SpineModelComponent* component)
     {
-        //dmGameObject::HCollection collection = dmGameObject::GetCollection(component->m_Instance);
-
         SpineModelResource* spine_model = component->m_Resource;
         //SpineSceneResource* spine_scene = spine_model->m_SpineScene;
 
@@ -283,12 +349,43 @@ namespace dmSpine
 
         component->m_Bones.SetCapacity(skeleton->bonesCount);
         component->m_BoneInstances.SetCapacity(skeleton->bonesCount);
+        component->m_BoneStates.SetCapacity(skeleton->bonesCount);
+        component->m_ActiveBones.SetCapacity(skeleton->bonesCount);
         component->m_BoneNameToNodeInstanceIndex.OffsetCapacity(skeleton->bonesCount);
-        if (!CreateGOBone(component, dmGameObject::GetCollection(component->m_Instance), component->m_Instance, 0, skeleton->root, 0))
+
+        dmGameObject::HCollection collection = dmGameObject::GetCollection(component->m_Instance);
+        bool result = true;
+        if (spine_model->m_GoBones.Empty())
+        {
+            result = CreateGOBone(component, collection, component->m_Instance, 0, skeleton->root, 0);
+        }
+        else
+        {
+            // Only the listed bones, the rest are created on demand in CompSpineModelGetBone
+            const dmArray<dmhash_t>& go_bones = spine_model->m_GoBones;
+            for (int i = 0; i < skeleton->bonesCount && result; ++i)
+            {
+                spBone* bone = skeleton->bones[i];
+                dmhash_t name_hash = dmHashString64(bone->data->name);
+                for (uint32_t j = 0; j < go_bones.Size(); ++j)
+                {
+                    if (go_bones[j] == name_hash)
+                    {
+                        result = CreateGOBoneInstance(component, collection, component->m_Instance, bone, name_hash);
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!result)
         {
             dmLogError("Failed to create bones");
             dmGameObject::DeleteBones(component->m_Instance); // iterates recursively and deletes the ones marked as a bone
+            component->m_Bones.SetSize(0);
             component->m_BoneInstances.SetSize(0);
+            component->m_BoneStates.SetSize(0);
+            component->m_BoneNameToNodeInstanceIndex.Clear();
             return false;
         }
         return true;
@@ -298,6 +395,8 @@ namespace dmSpine
     {
         component->m_Bones.SetSize(0);
         component->m_BoneInstances.SetSize(0);
+        component->m_BoneStates.SetSize(0);
+        component->m_ActiveBones.SetSize(0);
         component->m_BoneNameToNodeInstanceIndex.Clear();
         dmGameObject::DeleteBones(component->m_Instance);
         // Bones are created in CompSpineModelPostUpdate because the previous ones are removed there
@@ -423,7 +522,7 @@ namespace dmSpine
             return false;
         }
 
-        spAnimation* animation = spine_scene->m_Skeleton->animations[index];
+        spAnimation* animation = dmSpine::ResolveAnimation(spine_scene, index);
 
         if (track_index < 0)
         {
@@ -807,22 +906,18 @@ namespace dmSpine
         return dmGameObject::CREATE_RESULT_OK;
     }
 
+    // Only the bone instances that have been handed out to scripts are kept up to date.
+    // The others cannot have anything attached to them, since their ids are unknown.
     static bool UpdateBones(SpineModelComponent* component)
     {
-        if (component->m_BoneInstances.Empty())
-            return false;
-
-        uint32_t size = component->m_Bones.Size();
-        DM_PROPERTY_ADD_U32(rmtp_SpineBones, size);
+        bool updated = false;
+        uint32_t size = component->m_ActiveBones.Size();
         for (uint32_t n = 0; n < size; ++n)
         {
-            spBone* bone = component->m_Bones[n];
-
-            dmGameObject::HInstance bone_instance = component->m_BoneInstances[n];
-            SetTransformFromBone(bone_instance, component->m_Transform, bone);
+            updated |= WriteBoneTransform(component, component->m_ActiveBones[n], false);
         }
-
-        return true;
+        DM_PROPERTY_ADD_U32(rmtp_SpineBones, size);
+        return updated;
     }
 
     dmGameObject::CreateResult CompSpineModelAddToUpdate(const dmGameObject::ComponentAddToUpdateParams& params)
@@ -1113,6 +1208,7 @@ namespace dmSpine
                 world->m_RenderObjectOverflowBlocks.SetCapacity(new_capacity);
             }
             world->m_RenderObjectOverflowBlocks.Push(new dmRender::RenderObject[RENDER_OBJECT_OVERFLOW_BLOCK_SIZE]);
+            DM_PROPERTY_ADD_U32(rmtp_SpineRenderObjectOverflows, 1);
         }
 
         ++world->m_RenderObjectsInUse;
@@ -1138,6 +1234,138 @@ namespace dmSpine
         world->m_RenderObjectsInUse = 0;
     }
 
+    static void CountBatchBreak(SpineModelWorld* world, const SpineBatchKey& key)
+    {
+        DM_PROPERTY_ADD_U32(rmtp_SpineBatches, 1);
+
+        if (world->m_HasPreviousBatch)
+        {
+            const SpineBatchKey& prev = world->m_PreviousBatchKey;
+            if (prev.m_Material != key.m_Material)
+                DM_PROPERTY_ADD_U32(rmtp_SpineBatchBreakMaterial, 1);
+            else if (prev.m_Texture != key.m_Texture)
+                DM_PROPERTY_ADD_U32(rmtp_SpineBatchBreakTexture, 1);
+            else if (prev.m_BlendMode != key.m_BlendMode)
+                DM_PROPERTY_ADD_U32(rmtp_SpineBatchBreakBlendMode, 1);
+            else if (prev.m_MixedHash != key.m_MixedHash)
+                DM_PROPERTY_ADD_U32(rmtp_SpineBatchBreakConstants, 1);
+            else // Same state, but something else was sorted in between (or a different render order)
+                DM_PROPERTY_ADD_U32(rmtp_SpineBatchBreakOrder, 1);
+        }
+
+        world->m_PreviousBatchKey = key;
+        world->m_HasPreviousBatch = 1;
+    }
+
+    template <typename T>
+    static void SetScratchSize(dmArray<T>& array, uint32_t size)
+    {
+        if (array.Capacity() < size)
+        {
+            array.SetCapacity(dmMath::Max(size, dmMath::Max(16U, array.Capacity() * 2)));
+        }
+        array.SetSize(size);
+    }
+
+    static bool CompareBoundsMinX(const SpineModelBounds& a, const SpineModelBounds& b)
+    {
+        return a.minX < b.minX;
+    }
+
+    // Checks if the world space (xy) bounds of any two models in the batch overlap
+    static bool HasOverlappingBounds(SpineModelWorld* world, dmRender::RenderListEntry* buf, uint32_t* begin, uint32_t* end)
+    {
+        dmArray<SpineModelComponent*>& components = world->m_Components.GetRawObjects();
+
+        uint32_t count = (uint32_t)(end - begin);
+        SetScratchSize(world->m_BatchBounds, count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t component_index = (uint32_t)buf[begin[i]].m_UserData;
+            const SpineModelBounds& local = world->m_BoundingBoxes[component_index];
+            const Matrix4& transform = components[component_index]->m_World;
+
+            SpineModelBounds& bounds = world->m_BatchBounds[i];
+            bounds.minX = bounds.minY = FLT_MAX;
+            bounds.maxX = bounds.maxY = -FLT_MAX;
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                Vector4 p = transform * Point3((c & 1) ? local.maxX : local.minX, (c & 2) ? local.maxY : local.minY, 0.0f);
+                bounds.minX = dmMath::Min(bounds.minX, (float)p.getX());
+                bounds.minY = dmMath::Min(bounds.minY, (float)p.getY());
+                bounds.maxX = dmMath::Max(bounds.maxX, (float)p.getX());
+                bounds.maxY = dmMath::Max(bounds.maxY, (float)p.getY());
+            }
+        }
+
+        // Sweep along x, so we only test the models whose x ranges overlap
+        std::sort(world->m_BatchBounds.Begin(), world->m_BatchBounds.End(), CompareBoundsMinX);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const SpineModelBounds& a = world->m_BatchBounds[i];
+            for (uint32_t j = i + 1; j < count && world->m_BatchBounds[j].minX < a.maxX; ++j)
+            {
+                const SpineModelBounds& b = world->m_BatchBounds[j];
+                if (b.minY < a.maxY && a.minY < b.maxY)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    // Stable sorts the draw descs on their keys, and moves their indices to match the new order.
+    // Afterwards, the draw descs with the same key are consecutive, and can be merged.
+    static void ReorderDrawDescs(SpineModelWorld* world, uint32_t index_start, uint32_t max_key)
+    {
+        dmArray<SpineIndexedDrawDesc>& src = world->m_DrawDescBuffer;
+        dmArray<SpineIndexedDrawDesc>& dst = world->m_SortedDrawDescBuffer;
+        dmArray<SpineReorderBucket>& buckets = world->m_ReorderBuckets;
+        const dmArray<uint32_t>& keys = world->m_DrawDescKeys;
+        dmArray<uint32_t>& indices = world->m_IndexBufferData;
+        dmArray<uint32_t>& scratch = world->m_ReorderIndexScratch;
+
+        uint32_t desc_count = src.Size();
+
+        // Counting sort: first count the descs and indices per key, then turn that into start offsets
+        SetScratchSize(buckets, max_key + 1);
+        memset(buckets.Begin(), 0, buckets.Size() * sizeof(SpineReorderBucket));
+        for (uint32_t i = 0; i < desc_count; ++i)
+        {
+            buckets[keys[i]].m_DescOffset++;
+            buckets[keys[i]].m_IndexOffset += src[i].m_IndexCount;
+        }
+        uint32_t desc_offset = 0;
+        uint32_t index_offset = 0;
+        for (uint32_t k = 0; k <= max_key; ++k)
+        {
+            SpineReorderBucket& bucket = buckets[k];
+            uint32_t desc_bucket_count = bucket.m_DescOffset;
+            uint32_t index_bucket_count = bucket.m_IndexOffset;
+            bucket.m_DescOffset = desc_offset;
+            bucket.m_IndexOffset = index_offset;
+            desc_offset += desc_bucket_count;
+            index_offset += index_bucket_count;
+        }
+
+        SetScratchSize(dst, desc_count);
+        SetScratchSize(scratch, index_offset);
+        for (uint32_t i = 0; i < desc_count; ++i)
+        {
+            SpineReorderBucket& bucket = buckets[keys[i]];
+            const SpineIndexedDrawDesc& desc = src[i];
+
+            memcpy(&scratch[bucket.m_IndexOffset], &indices[desc.m_IndexStart], desc.m_IndexCount * sizeof(uint32_t));
+
+            SpineIndexedDrawDesc& sorted = dst[bucket.m_DescOffset++];
+            sorted = desc;
+            sorted.m_IndexStart = index_start + bucket.m_IndexOffset;
+            bucket.m_IndexOffset += desc.m_IndexCount;
+        }
+
+        memcpy(&indices[index_start], scratch.Begin(), scratch.Size() * sizeof(uint32_t));
+        src.Swap(dst);
+    }
+
     static void RenderBatch(SpineModelWorld* world, dmRender::HRenderContext render_context, dmRender::RenderListEntry *buf, uint32_t* begin, uint32_t* end)
     {
         //DM_PROFILE(SpineModel, "RenderBatch");
@@ -1151,6 +1379,14 @@ namespace dmSpine
         dmGameSystemDDF::SpineModelDesc::BlendMode blend_mode = resource->m_Ddf->m_BlendMode;
         bool use_inherit_blend = blend_mode == dmGameSystemDDF::SpineModelDesc::BLEND_MODE_INHERIT;
 
+        // Interleaving the models is only safe if they don't overlap on screen
+        dmGameSystemDDF::SpineModelDesc::BlendReorder blend_reorder = use_inherit_blend ? resource->m_Ddf->m_BlendReorder : dmGameSystemDDF::SpineModelDesc::BLEND_REORDER_NONE;
+        if (blend_reorder == dmGameSystemDDF::SpineModelDesc::BLEND_REORDER_NON_OVERLAPPING)
+        {
+            if ((end - begin) < 2 || HasOverlappingBounds(world, buf, begin, end))
+                blend_reorder = dmGameSystemDDF::SpineModelDesc::BLEND_REORDER_NONE;
+        }
+
         uint32_t index_start            = world->m_IndexBufferData.Size();
         uint32_t draw_desc_buffer_count = 0;
 
@@ -1173,11 +1409,34 @@ namespace dmSpine
             world->m_DrawDescBuffer.SetCapacity(new_capacity);
         }
 
+        world->m_DrawDescKeys.SetSize(0);
+        uint32_t max_key = 0;
+
         for (uint32_t *i = begin; i != end; ++i)
         {
             component_index = (uint32_t)buf[*i].m_UserData;
             const SpineModelComponent* component = (const SpineModelComponent*) components[component_index];
+            uint32_t draw_desc_start = world->m_DrawDescBuffer.Size();
             dmSpine::GenerateIndexedVertexData(world->m_VertexBufferData, world->m_IndexBufferData, component->m_SkeletonInstance, world->m_SkeletonClipper, component->m_World, Vector4(1.0f), use_inherit_blend ? &world->m_DrawDescBuffer : 0, world->m_GeometryScratch);
+
+            if (blend_reorder == dmGameSystemDDF::SpineModelDesc::BLEND_REORDER_NONE)
+                continue;
+
+            // Order independent: group all slots on blend mode.
+            // Non overlapping: the n'th blend mode change within each model goes to group n,
+            // which keeps the draw order within the model, but interleaves the models.
+            uint32_t draw_desc_end = world->m_DrawDescBuffer.Size();
+            SetScratchSize(world->m_DrawDescKeys, draw_desc_end);
+            uint32_t run = 0;
+            for (uint32_t d = draw_desc_start; d < draw_desc_end; ++d)
+            {
+                uint32_t desc_blend_mode = world->m_DrawDescBuffer[d].m_BlendMode;
+                if (d > draw_desc_start && desc_blend_mode != world->m_DrawDescBuffer[d-1].m_BlendMode)
+                    ++run;
+                uint32_t key = blend_reorder == dmGameSystemDDF::SpineModelDesc::BLEND_REORDER_ORDER_INDEPENDENT ? desc_blend_mode : run;
+                world->m_DrawDescKeys[d] = key;
+                max_key = dmMath::Max(max_key, key);
+            }
         }
 
         uint32_t index_count = world->m_IndexBufferData.Size() - index_start;
@@ -1186,14 +1445,26 @@ namespace dmSpine
             return;
         }
 
-        dmGraphics::HTexture texture = GetSpineScene(first)->m_TextureSet->m_Texture->m_Texture; // spine - texture set resource - texture resource - texture
+        // A multi page atlas is a single texture array, and each vertex carries its page index,
+        // so the whole batch is still drawn with one texture (see spine_paged_atlas.material)
+        dmGraphics::HTexture texture = GetTexture(first);
         dmRender::HMaterial material = GetMaterial(first);
 
+        SpineBatchKey batch_key;
+        batch_key.m_Material  = material;
+        batch_key.m_Texture   = texture;
+        batch_key.m_BlendMode = blend_mode;
+        batch_key.m_MixedHash = first->m_MixedHash;
+        CountBatchBreak(world, batch_key);
+
         if (use_inherit_blend)
         {
             uint32_t draw_desc_count = world->m_DrawDescBuffer.Size();
             if (draw_desc_count > 0)
             {
+                if (blend_reorder != dmGameSystemDDF::SpineModelDesc::BLEND_REORDER_NONE)
+                    ReorderDrawDescs(world, index_start, max_key);
+
                 MergeIndexedDrawDescs(world->m_DrawDescBuffer, world->m_MergedDrawDescBuffer);
 
                 uint32_t merged_size = world->m_MergedDrawDescBuffer.Size();
@@ -1264,6 +1535,7 @@ namespace dmSpine
             case dmRender::RENDER_LIST_OPERATION_BEGIN:
             {
                 PrepareRenderObjectsForFrame(world);
+                world->m_HasPreviousBatch = 0;
                 world->m_VertexBufferData.SetSize(0);
                 world->m_IndexBufferData.SetSize(0);
                 world->m_PackedIndexBufferData.SetSize(0);
@@ -1309,6 +1581,13 @@ namespace dmSpine
                         render_objects_left -= render_objects_in_block;
                     }
 
+                    if (world->m_RenderObjectsInUse > g_RenderObjectsPeak)
+                    {
+                        g_RenderObjectsPeak = world->m_RenderObjectsInUse;
+                        DM_PROPERTY_SET_U32(rmtp_SpineRenderObjectsPeak, g_RenderObjectsPeak);
+                    }
+
+                    DM_PROPERTY_ADD_U32(rmtp_SpineRenderObjects, world->m_RenderObjectsInUse);
                     DM_PROPERTY_ADD_U32(rmtp_SpineVertexCount, world->m_VertexBufferData.Size());
                     DM_PROPERTY_ADD_U32(rmtp_SpineVertexSize, vertex_data_size);
                     DM_PROPERTY_ADD_U32(rmtp_SpineIndexSize, index_data_size);
@@ -1409,6 +1688,11 @@ namespace dmSpine
         return true;
     }
 
+    bool CompSpineModelPrefetchAnimation(SpineModelComponent* component, dmhash_t animation_id)
+    {
+        return PrefetchAnimation(GetSpineScene(component), animation_id);
+    }
+
     bool CompSpineModelResetConstant(SpineModelComponent* component, dmGameSystemDDF::ResetConstant* message)
     {
         if (component->m_RenderConstants)
@@ -1697,6 +1981,7 @@ namespace dmSpine
 
         int32_t max_rig_instance = dmConfigFile::GetInt(ctx->m_Config, "rig.max_instance_count", 128);
         spinemodelctx->m_MaxSpineModelCount = dmMath::Max(dmConfigFile::GetInt(ctx->m_Config, "spine.max_count", 128), max_rig_instance);
+        spinemodelctx->m_MaxRenderObjectCount = dmMath::Max(dmConfigFile::GetInt(ctx->m_Config, "spine.max_render_objects", 0), 0);
 
         // Spine system setup
         spBone_setYDown(0); // so we'll only call it once
@@ -1991,11 +2276,88 @@ namespace dmSpine
         return 1 == spSkeleton_setAttachment(component->m_SkeletonInstance, slot->data->name, attachment_name);
     }
 
+    int32_t GetBoneIndex(HSpineModel component, dmhash_t bone_id)
+    {
+        uint32_t* index = GetSpineScene(component)->m_BoneNameToIndex.Get(bone_id);
+        return index ? (int32_t)*index : -1;
+    }
+
+    bool GetBoneWorldTransforms(HSpineModel component, const int32_t* bone_indices, uint32_t count, Matrix4* out)
+    {
+        const spSkeleton* skeleton = component->m_SkeletonInstance;
+        if (!skeleton)
+            return false;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            int32_t index = bone_indices[i];
+            if (index < 0 || index >= skeleton->bonesCount)
+                return false;
+
+            // The bone world matrix is in the skeleton space
+            const spBone* bone = skeleton->bones[index];
+            Matrix4 bone_matrix(Vector4(bone->a, bone->c, 0.0f, 0.0f),
+                                Vector4(bone->b, bone->d, 0.0f, 0.0f),
+                                Vector4(0.0f, 0.0f, 1.0f, 0.0f),
+                                Vector4(bone->worldX, bone->worldY, 0.0f, 1.0f));
+            out[i] = component->m_World * bone_matrix;
+        }
+        return true;
+    }
+
+    // Creates the game object for a bone that wasn't in the go_bones list
+    static bool CreateGOBoneOnDemand(SpineModelComponent* component, dmhash_t bone_name)
+    {
+        if (!component->m_Resource->m_CreateGoBones || component->m_RebuildBonesPending)
+            return false;
+
+        // The bone index comes from the spine scene of the model, which is also the one
+        // the skeleton instance was created from, whether or not it's been overridden
+        spSkeleton* skeleton = component->m_SkeletonInstance;
+        int32_t index = GetBoneIndex(component, bone_name);
+        if (!skeleton || index < 0 || index >= skeleton->bonesCount)
+            return false;
+
+        // The arrays are sized for all bones in CreateGOBones, but a failed creation leaves them empty
+        if (component->m_BoneInstances.Full())
+        {
+            uint32_t capacity = (uint32_t)skeleton->bonesCount;
+            component->m_Bones.SetCapacity(capacity);
+            component->m_BoneInstances.SetCapacity(capacity);
+            component->m_BoneStates.SetCapacity(capacity);
+            component->m_ActiveBones.SetCapacity(capacity);
+        }
+        if (component->m_BoneNameToNodeInstanceIndex.Full())
+        {
+            component->m_BoneNameToNodeInstanceIndex.OffsetCapacity(8);
+        }
+
+        spBone* bone = skeleton->bones[index];
+        if (!CreateGOBoneInstance(component, dmGameObject::GetCollection(component->m_Instance), component->m_Instance, bone, bone_name))
+        {
+            dmLogError("Failed to create game object for bone '%s'. Consider increasing collection max instances (collection.max_instances).", bone->data->name);
+            return false;
+        }
+        return true;
+    }
+
     bool CompSpineModelGetBone(SpineModelComponent* component, dmhash_t bone_name, dmhash_t* instance_id)
     {
         uint32_t* index = component->m_BoneNameToNodeInstanceIndex.Get(bone_name);
         if (!index)
-            return false;
+        {
+            if (!CreateGOBoneOnDemand(component, bone_name))
+                return false;
+            index = component->m_BoneNameToNodeInstanceIndex.Get(bone_name);
+        }
+        BoneInstanceState& state = component->m_BoneStates[*index];
+        if (!state.m_Active)
+        {
+            state.m_Active = 1;
+            component->m_ActiveBones.Push(*index);
+            WriteBoneTransform(component, *index, true);
+        }
+
         dmGameObject::HInstance bone_instance = component->m_BoneInstances[*index];
         *instance_id = dmGameObject::GetIdentifier(bone_instance);
         return true;
@@ -26,6 +26,7 @@
 // The engine ddf formats aren't stored in the "dmsdk" folder (yet)
 #include <gamesys/gamesys_ddf.h>
 
+#include <spine_extension/spine.h>
 #include "res_spine_model.h"
 
 struct spAnimationState;
@@ -58,6 +59,13 @@ namespace dmSpine
         dmVMath::Point3                         m_Position;
     };
 
+    struct BoneInstanceState
+    {
+        float                                   m_Matrix[6];    // The bone world matrix (a, b, c, d, worldX, worldY) last written to the instance
+        uint8_t                                 m_Active : 1;   // The instance has been handed out (e.g. by spine.get_go), and is kept up to date
+        uint8_t                                 : 7;
+    };
+
     struct SpineModelComponent
     {
         dmGameObject::HInstance                 m_Instance;
@@ -75,6 +83,8 @@ namespace dmSpine
         dmArray<dmGameObject::HInstance>        m_BoneInstances;
         dmArray<spBone*>                        m_Bones;                        // We shouldn't really have to have a duplicate array of these
         dmHashTable64<uint32_t>                 m_BoneNameToNodeInstanceIndex;  // should really be in the spine_scene
+        dmArray<BoneInstanceState>              m_BoneStates;                   // Matches 1:1 with m_BoneInstances
+        dmArray<uint32_t>                       m_ActiveBones;                  // Indices of the bone instances that are kept up to date
 
         dmArray<dmSpine::IKTarget>              m_IKTargets;
         dmArray<dmSpine::IKTarget>              m_IKTargetPositions;
@@ -91,6 +101,7 @@ namespace dmSpine
     // For scripting
     bool CompSpineModelPlayAnimation(SpineModelComponent* component, dmGameSystemDDF::SpinePlayAnimation* message, dmMessage::URL* sender, dmScript::LuaCallbackInfo* callback_info, lua_State* L);
     bool CompSpineModelCancelAnimation(SpineModelComponent* component, dmGameSystemDDF::SpineCancelAnimation* message);
+    bool CompSpineModelPrefetchAnimation(SpineModelComponent* component, dmhash_t animation_id);
 
     bool CompSpineModelResetConstant(SpineModelComponent* component, dmGameSystemDDF::ResetConstant* message);
 
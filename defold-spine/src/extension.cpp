@@ -3,9 +3,13 @@
 #include "script_spine.h"
 #include "script_spine_resource.h"
 #include "gui_spine.h"
+#include "res_spine_scene.h"
 
 static dmExtension::Result AppInitializeSpine(dmExtension::AppParams* params)
 {
+    // Read before any spine scenes are loaded
+    dmSpine::SetLazyAnimations(dmConfigFile::GetInt(params->m_ConfigFile, "spine.lazy_animations", 0) != 0);
+    dmSpine::SetCompactCurves(dmConfigFile::GetInt(params->m_ConfigFile, "spine.compact_curves", 0) != 0);
     return dmExtension::RESULT_OK;
 }
 
@@ -19,6 +23,13 @@ static dmExtension::Result InitializeSpine(dmExtension::Params* params)
     return dmExtension::RESULT_OK;
 }
 
+static dmExtension::Result UpdateSpine(dmExtension::Params* params)
+{
+    dmSpine::ScriptSpineResourceUpdate();
+    dmSpine::GuiSpineUpdate();
+    return dmExtension::RESULT_OK;
+}
+
 static dmExtension::Result AppFinalizeSpine(dmExtension::AppParams* params)
 {
     return dmExtension::RESULT_OK;
@@ -26,10 +37,11 @@ static dmExtension::Result AppFinalizeSpine(dmExtension::AppParams* params)
 
 static dmExtension::Result FinalizeSpine(dmExtension::Params* params)
 {
+    dmSpine::ScriptSpineResourceFinalize();
     dmSpine::GuiSpineFinalize();
     return dmExtension::RESULT_OK;
 }
 
 
 // DM_DECLARE_EXTENSION(symbol, name, app_init, app_final, init, update, on_event, final)
-DM_DECLARE_EXTENSION(SpineExt, "SpineExt", AppInitializeSpine, AppFinalizeSpine, InitializeSpine, 0, 0, FinalizeSpine);
+DM_DECLARE_EXTENSION(SpineExt, "SpineExt", AppInitializeSpine, AppFinalizeSpine, InitializeSpine, UpdateSpine, 0, FinalizeSpine);
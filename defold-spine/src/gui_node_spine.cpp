@@ -22,6 +22,10 @@
 #include <spine/Bone.h>
 #include <spine/IkConstraint.h>
 
+#include <float.h> // FLT_MAX
+#include <stddef.h> // offsetof
+#include <math.h> // M_PI
+
 #include "spine_ddf.h" // generated from the spine_ddf.proto
 #include "script_spine_gui.h"
 #include "gui_spine.h"
@@ -30,6 +34,14 @@
 DM_PROPERTY_EXTERN(rmtp_Spine);
 DM_PROPERTY_EXTERN(rmtp_SpineBones);
 DM_PROPERTY_U32(rmtp_SpineGuiNodes, 0, PROFILE_PROPERTY_FRAME_RESET, "", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineGuiBoneUpdates, 0, PROFILE_PROPERTY_FRAME_RESET, "# gui bone nodes updated", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineGuiNodesCulled, 0, PROFILE_PROPERTY_FRAME_RESET, "# gui nodes skipped during vertex generation", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineGuiNodesRendered, 0, PROFILE_PROPERTY_FRAME_RESET, "# gui nodes rendered", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineGuiVertexCount, 0, PROFILE_PROPERTY_FRAME_RESET, "# gui vertices", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineGuiBatchBreakTexture, 0, PROFILE_PROPERTY_FRAME_RESET, "# gui batch breaks due to texture", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineGuiBatchBreakBlendMode, 0, PROFILE_PROPERTY_FRAME_RESET, "# gui batch breaks due to blend mode", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineGuiBatchBreakClipping, 0, PROFILE_PROPERTY_FRAME_RESET, "# gui batch breaks due to clipping", &rmtp_Spine);
+DM_PROPERTY_U32(rmtp_SpineGuiSlotBlendOverrides, 0, PROFILE_PROPERTY_FRAME_RESET, "# gui slots drawn with the node blend mode instead of their own", &rmtp_Spine);
 
 namespace dmSpine
 {
@@ -39,7 +51,19 @@ static const dmhash_t SPINE_CREATE_BONES        = dmHashString64("spine_create_b
 
 struct GuiNodeTypeContext
 {
-    spSkeletonClipping* m_SkeletonClipper;
+    spSkeletonClipping*         m_SkeletonClipper;
+    dmArray<dmVMath::Vector4>   m_PositionScratch; // Kept to avoid allocating in each GenerateVertexData() call
+    dmArray<float>              m_BoundsScratch;
+
+    // The last spine node that generated vertices, to tell which consecutive spine nodes can share a batch
+    dmGui::HScene               m_BatchScene;
+    void*                       m_BatchTexture;
+    uint32_t                    m_BatchBlendMode;
+};
+
+struct GuiBoneState
+{
+    float   m_Matrix[6];        // The bone world matrix (a, b, c, d, worldX, worldY) last written to the gui node
 };
 
 struct InternalGuiNode
@@ -56,6 +80,9 @@ struct InternalGuiNode
 
     dmVMath::Matrix4    m_Transform; // the world transform
 
+    SpineModelBounds    m_LocalBounds;  // Skeleton bounds in node space, refreshed lazily after the pose changes (only with a cull rect)
+    dmVMath::Vector4    m_CullRect;     // Visible area (x, y, width, height) in the parent node space
+
     dmGui::HScene       m_GuiScene;
     dmGui::HNode        m_GuiNode;
     dmGui::AdjustMode   m_AdjustMode;
@@ -65,16 +92,23 @@ struct InternalGuiNode
     dmArray<dmhash_t>       m_BonesIds;     // Matches 1:1 with m_BoneNodes     (each element is hash(scene_name/bone_name))
     dmArray<dmhash_t>       m_BonesNames;   // Matches 1:1 with m_BoneNodes (each element is hash(bone_name)))
     dmArray<spBone*>        m_Bones;        // Matches 1:1 with m_BoneNodes
+    dmArray<GuiBoneState>   m_BoneStates;   // Matches 1:1 with m_BoneNodes
 
     // IK targets for GUI spine nodes
     dmArray<GuiIKTarget>    m_IKTargets;           // targets that follow GUI nodes
     dmArray<GuiIKTarget>    m_IKTargetPositions;   // targets with fixed positions
 
     uint32_t            m_CallbackInvocationDepth;
+    uint32_t            m_SceneNodeIndex;       // Slot in the scene's list of spine nodes (see GuiSpineRegisterNode)
 
     uint8_t             m_FindBones : 1;
     uint8_t             m_FirstUpdate : 1;
-    uint8_t             : 6;
+    uint8_t             m_BoundsDirty : 1;
+    uint8_t             m_UseCullRect : 1;
+    uint8_t             m_PoseDirty : 1;        // The bones changed outside of animation playback (e.g. setup pose, IK, physics)
+    uint8_t             m_WorldTransformDirty : 1; // Time was advanced while the node was hidden, the world transform is stale
+    uint8_t             m_Rendered : 1;         // Vertices were generated since the last update
+    uint8_t             m_Clipping : 1;         // The node is a clipper, from the node desc
 
     InternalGuiNode()
     : m_SpinePath(0)
@@ -84,8 +118,15 @@ struct InternalGuiNode
     , m_SkinId(0)
     , m_Id(0)
     , m_CallbackInvocationDepth(0)
+    , m_SceneNodeIndex(0xFFFFFFFF)
     , m_FindBones(0)
     , m_FirstUpdate(1)
+    , m_BoundsDirty(1)
+    , m_UseCullRect(0)
+    , m_PoseDirty(1)
+    , m_WorldTransformDirty(0)
+    , m_Rendered(1)
+    , m_Clipping(0)
     {}
 };
 
@@ -421,7 +462,7 @@ static bool PlayAnimation(InternalGuiNode* node, dmhash_t animation_id, dmGui::P
     int trackIndex = track - 1; // Convert from 1-based to 0-based indexing
     int loop = IsLooping(playback);
 
-    spAnimation* animation = spine_scene->m_Skeleton->animations[index];
+    spAnimation* animation = dmSpine::ResolveAnimation(spine_scene, index);
 
     // Ensure we have enough tracks
     if (trackIndex >= node->m_AnimationTracks.Capacity())
@@ -524,13 +565,17 @@ dmGui::HNode GetBone(dmGui::HScene scene, dmGui::HNode hnode, dmhash_t bone_id)
     for (uint32_t i = 0; i < count; ++i)
     {
         if (node->m_BonesIds[i] == bone_id)
+        {
             return node->m_BonesNodes[i];
+        }
     }
     count = node->m_BonesNames.Size();
     for (uint32_t i = 0; i < count; ++i)
     {
         if (node->m_BonesNames[i] == bone_id)
+        {
             return node->m_BonesNodes[i];
+        }
     }
     return 0;
 }
@@ -675,6 +720,7 @@ bool SetSkin(dmGui::HScene scene, dmGui::HNode hnode, dmhash_t skin_id)
 
     spSkeleton_setSkin(node->m_SkeletonInstance, skin);
     spSkeleton_setSlotsToSetupPose(node->m_SkeletonInstance);
+    node->m_BoundsDirty = 1;
     return true;
 }
 
@@ -787,6 +833,7 @@ bool SetAttachment(dmGui::HScene scene, dmGui::HNode hnode, dmhash_t slot_id, dm
     }
 
     spSlot* slot = node->m_SkeletonInstance->slots[*index];
+    node->m_BoundsDirty = 1;
 
     // it's a bit weird to use strings here, but we'd rather not use too much knowledge about the internals
     return 1 == spSkeleton_setAttachment(node->m_SkeletonInstance, slot->data->name, attachment_name);
@@ -814,12 +861,14 @@ void PhysicsTranslate(dmGui::HScene scene, dmGui::HNode hnode, Vectormath::Aos::
 {
     InternalGuiNode* node = (InternalGuiNode*)dmGui::GetNodeCustomData(scene, hnode);
     spSkeleton_physicsTranslate(node->m_SkeletonInstance, translation->getX(), translation->getY());
+    node->m_PoseDirty = 1;
 }
 
 void PhysicsRotate(dmGui::HScene scene, dmGui::HNode hnode, Vectormath::Aos::Vector3* center, float degrees)
 {
     InternalGuiNode* node = (InternalGuiNode*)dmGui::GetNodeCustomData(scene, hnode);
     spSkeleton_physicsRotate(node->m_SkeletonInstance, center->getX(), center->getY(), degrees);
+    node->m_PoseDirty = 1;
 }
 
 
@@ -836,6 +885,7 @@ static void DeleteBones(InternalGuiNode* node)
     node->m_BonesIds.SetSize(0);
     node->m_BonesNames.SetSize(0);
     node->m_Bones.SetSize(0);
+    node->m_BoneStates.SetSize(0);
 }
 
 static void UpdateTransform(dmGui::HScene scene, dmGui::HNode node, const spBone* bone)
@@ -849,6 +899,23 @@ static void UpdateTransform(dmGui::HScene scene, dmGui::HNode node, const spBone
     dmGui::SetNodeProperty(scene, node, dmGui::PROPERTY_SCALE, dmVMath::Vector4(sx, sy, 1, 0));
 }
 
+static GuiBoneState MakeBoneState(const spBone* bone)
+{
+    GuiBoneState state;
+    if (bone)
+    {
+        const float matrix[6] = { bone->a, bone->b, bone->c, bone->d, bone->worldX, bone->worldY };
+        memcpy(state.m_Matrix, matrix, sizeof(matrix));
+    }
+    else
+    {
+        // Unknown transform, makes sure the next update writes it
+        for (int i = 0; i < 6; ++i)
+            state.m_Matrix[i] = FLT_MAX;
+    }
+    return state;
+}
+
 static dmGui::HNode CreateBone(dmGui::HScene scene, dmGui::HNode gui_parent, dmGui::AdjustMode adjust_mode, const char* spine_gui_node_id, spBone* bone)
 {
     dmVMath::Point3 position = dmVMath::Point3(bone->x, bone->y, 0);
@@ -880,6 +947,7 @@ static bool CreateBones(InternalGuiNode* node, dmGui::HScene scene, dmGui::HNode
     node->m_BonesIds.Push(dmGui::GetNodeId(scene, gui_bone));
     node->m_BonesNames.Push(dmHashString64(bone->data->name));
     node->m_Bones.Push(bone);
+    node->m_BoneStates.Push(MakeBoneState(bone));
 
     int count = bone->childrenCount;
     for (int i = 0; i < count; ++i)
@@ -911,22 +979,44 @@ static bool CreateBones(InternalGuiNode* node)
         node->m_BonesIds.SetCapacity(num_bones);
         node->m_BonesNames.SetCapacity(num_bones);
         node->m_Bones.SetCapacity(num_bones);
+        node->m_BoneStates.SetCapacity(num_bones);
     }
 
     return CreateBones(node, node->m_GuiScene, node->m_GuiNode, node->m_SkeletonInstance->root);
 }
 
+// Every bone node can be observed (e.g. found with gui.get_node), so all of them are kept up to date,
+// but a node is only written when its bone matrix changed since the last write.
 static void UpdateBones(InternalGuiNode* node)
 {
     dmGui::HScene scene = node->m_GuiScene;
     uint32_t num_bones = node->m_BonesNodes.Size();
+    if (num_bones == 0)
+        return;
 
     DM_PROPERTY_ADD_U32(rmtp_SpineBones, num_bones);
+    uint32_t num_updated = 0;
     for (uint32_t i = 0; i < num_bones; ++i)
     {
         dmGui::HNode gui_bone = node->m_BonesNodes[i];
-        spBone* bone = node->m_Bones[i];
+        GuiBoneState& state = node->m_BoneStates[i];
+
+        // Bone nodes can be read by scripts at any time (e.g. via gui.get_node("spine_node_id/bone_name")),
+        // so all of them are kept up to date, but only the ones that moved are written
+        const spBone* bone = node->m_Bones[i];
+        const float matrix[6] = { bone->a, bone->b, bone->c, bone->d, bone->worldX, bone->worldY };
+        if (memcmp(state.m_Matrix, matrix, sizeof(matrix)) == 0)
+            continue;
+
+        memcpy(state.m_Matrix, matrix, sizeof(matrix));
         UpdateTransform(scene, gui_bone, bone);
+        ++num_updated;
+    }
+
+    DM_PROPERTY_ADD_U32(rmtp_SpineGuiBoneUpdates, num_updated);
+    if (num_updated)
+    {
+        GuiSpineGetFrameStats(scene)->m_BoneUpdates += num_updated;
     }
 }
 
@@ -934,6 +1024,7 @@ static void FindGuiBones(InternalGuiNode* node, dmGui::HScene scene, dmGui::HNod
 {
     // We assume the order is the same as when we created them in the original spine node
     node->m_BonesNodes.Push(hnode);
+    node->m_BoneStates.Push(MakeBoneState(0));
 
     dmGui::HNode child = dmGui::GetFirstChildNode(scene, hnode);
 
@@ -1006,7 +1097,7 @@ static void* GuiCreate(const dmGameSystem::CompGuiNodeContext* ctx, void* contex
     node_data->m_GuiNode = node;
     node_data->m_FirstUpdate = 1;
     dmSpine::GuiSpineSceneRetain(scene);
-    dmSpine::GuiSpineRegisterNode(scene, node);
+    dmSpine::GuiSpineRegisterNode(scene, node, &node_data->m_SceneNodeIndex);
     return node_data;
 }
 
@@ -1022,9 +1113,10 @@ static void GuiDestroy(const dmGameSystem::CompGuiNodeContext* ctx, const dmGame
     assert(node->m_CallbackInvocationDepth == 0);
     DestroyDeferredCallbacks(node);
 
+    // The registry points into the node data, so unregister before deleting it
+    dmSpine::GuiSpineUnregisterNode(nodectx->m_Scene, nodectx->m_Node, &node->m_SceneNodeIndex);
     delete node;
     dmSpine::GuiSpineSceneRelease(nodectx->m_Scene);
-    dmSpine::GuiSpineUnregisterNode(nodectx->m_Scene, nodectx->m_Node);
 }
 
 static bool SetupNode(dmhash_t path, SpineSceneResource* resource, InternalGuiNode* node, bool create_bones)
@@ -1058,6 +1150,8 @@ static bool SetupNode(dmhash_t path, SpineSceneResource* resource, InternalGuiNo
 
     spSkeleton_setToSetupPose(node->m_SkeletonInstance);
     spSkeleton_updateWorldTransform(node->m_SkeletonInstance, SP_PHYSICS_NONE);
+    node->m_PoseDirty = 1;
+    node->m_BoundsDirty = 1;
 
     node->m_Transform = dmVMath::Matrix4::identity();
 
@@ -1072,6 +1166,199 @@ static bool SetupNode(dmhash_t path, SpineSceneResource* resource, InternalGuiNo
 
 }
 
+// Copies the current pose (bones, slots, draw order and constraint state) between two instances of the same skeleton
+static void CopySkeletonPose(spSkeleton* dst, const spSkeleton* src)
+{
+    dst->color  = src->color;
+    dst->scaleX = src->scaleX;
+    dst->scaleY = src->scaleY;
+    dst->x      = src->x;
+    dst->y      = src->y;
+    dst->time   = src->time;
+
+    // Local, applied and world transforms are laid out contiguously, from x to worldY
+    const size_t bone_pose_size = offsetof(spBone, sorted) - offsetof(spBone, x);
+    for (int i = 0; i < src->bonesCount; ++i)
+    {
+        const spBone* sbone = src->bones[i];
+        spBone* dbone = dst->bones[i];
+        memcpy(&dbone->x, &sbone->x, bone_pose_size);
+        dbone->active  = sbone->active;
+        dbone->inherit = sbone->inherit;
+    }
+
+    for (int i = 0; i < src->slotsCount; ++i)
+    {
+        const spSlot* sslot = src->slots[i];
+        spSlot* dslot = dst->slots[i];
+        dslot->color = sslot->color;
+        if (dslot->darkColor && sslot->darkColor)
+            *dslot->darkColor = *sslot->darkColor;
+        spSlot_setAttachment(dslot, sslot->attachment);
+        dslot->attachmentState = sslot->attachmentState;
+        dslot->sequenceIndex   = sslot->sequenceIndex;
+
+        if (dslot->deformCapacity < sslot->deformCount)
+        {
+            FREE(dslot->deform);
+            dslot->deform = MALLOC(float, sslot->deformCount);
+            dslot->deformCapacity = sslot->deformCount;
+        }
+        dslot->deformCount = sslot->deformCount;
+        if (sslot->deformCount)
+            memcpy(dslot->deform, sslot->deform, sizeof(float) * sslot->deformCount);
+    }
+
+    for (int i = 0; i < src->slotsCount; ++i)
+    {
+        dst->drawOrder[i] = dst->slots[src->drawOrder[i]->data->index];
+    }
+
+    for (int i = 0; i < src->ikConstraintsCount; ++i)
+    {
+        const spIkConstraint* sik = src->ikConstraints[i];
+        spIkConstraint* dik = dst->ikConstraints[i];
+        dik->bendDirection = sik->bendDirection;
+        dik->compress      = sik->compress;
+        dik->stretch       = sik->stretch;
+        dik->mix           = sik->mix;
+        dik->softness      = sik->softness;
+        dik->active        = sik->active;
+    }
+
+    for (int i = 0; i < src->transformConstraintsCount; ++i)
+    {
+        const spTransformConstraint* stc = src->transformConstraints[i];
+        spTransformConstraint* dtc = dst->transformConstraints[i];
+        dtc->mixRotate = stc->mixRotate;
+        dtc->mixX      = stc->mixX;
+        dtc->mixY      = stc->mixY;
+        dtc->mixScaleX = stc->mixScaleX;
+        dtc->mixScaleY = stc->mixScaleY;
+        dtc->mixShearY = stc->mixShearY;
+        dtc->active    = stc->active;
+    }
+
+    for (int i = 0; i < src->pathConstraintsCount; ++i)
+    {
+        const spPathConstraint* spc = src->pathConstraints[i];
+        spPathConstraint* dpc = dst->pathConstraints[i];
+        dpc->position  = spc->position;
+        dpc->spacing   = spc->spacing;
+        dpc->mixRotate = spc->mixRotate;
+        dpc->mixX      = spc->mixX;
+        dpc->mixY      = spc->mixY;
+        dpc->active    = spc->active;
+    }
+
+    // The simulation state runs from inertia to scaleVelocity
+    const size_t physics_state_size = offsetof(spPhysicsConstraint, active) - offsetof(spPhysicsConstraint, inertia);
+    for (int i = 0; i < src->physicsConstraintsCount; ++i)
+    {
+        const spPhysicsConstraint* sphys = src->physicsConstraints[i];
+        spPhysicsConstraint* dphys = dst->physicsConstraints[i];
+        memcpy(&dphys->inertia, &sphys->inertia, physics_state_size);
+        dphys->active    = sphys->active;
+        dphys->remaining = sphys->remaining;
+        dphys->lastTime  = sphys->lastTime;
+    }
+}
+
+// Starts the same animations as the source node, at the same point in time.
+// The animations are already resolved in the source track entries, so no lookup by name is needed.
+// Mixing between animations isn't carried over, the clone starts at the target animation
+static void CopyTracks(InternalGuiNode* dst, const InternalGuiNode* src)
+{
+    uint32_t num_tracks = src->m_AnimationTracks.Size();
+    dst->m_AnimationTracks.SetCapacity(dmMath::Max(num_tracks, 8U));
+    dst->m_AnimationTracks.SetSize(num_tracks);
+
+    for (uint32_t i = 0; i < num_tracks; i++)
+    {
+        const GuiSpineAnimationTrack& srcTrack = src->m_AnimationTracks[i];
+        GuiSpineAnimationTrack& dstTrack = dst->m_AnimationTracks[i];
+
+        dstTrack.m_AnimationId = srcTrack.m_AnimationId;
+        dstTrack.m_Playback = srcTrack.m_Playback;
+        dstTrack.m_CallbackInfo = nullptr; // Don't copy callbacks
+        dstTrack.m_CallbackId = 0;
+        dstTrack.m_AnimationInstance = nullptr;
+
+        const spTrackEntry* sentry = srcTrack.m_AnimationInstance;
+        if (!srcTrack.m_AnimationId || !sentry || !sentry->animation)
+            continue;
+
+        spTrackEntry* dentry = spAnimationState_setAnimation(dst->m_AnimationStateInstance, i, sentry->animation, sentry->loop);
+        dstTrack.m_AnimationInstance = dentry;
+        if (!dentry)
+            continue;
+
+        // Copy the state of the animation
+        dentry->holdPrevious             = sentry->holdPrevious;
+        dentry->reverse                  = sentry->reverse;
+        dentry->shortestRotation         = sentry->shortestRotation;
+        dentry->eventThreshold           = sentry->eventThreshold;
+        dentry->mixAttachmentThreshold   = sentry->mixAttachmentThreshold;
+        dentry->alphaAttachmentThreshold = sentry->alphaAttachmentThreshold;
+        dentry->mixDrawOrderThreshold    = sentry->mixDrawOrderThreshold;
+        dentry->animationStart           = sentry->animationStart;
+        dentry->animationEnd             = sentry->animationEnd;
+        dentry->animationLast            = sentry->animationLast;
+        dentry->nextAnimationLast        = sentry->nextAnimationLast;
+        dentry->delay                    = sentry->delay;
+        dentry->trackTime                = sentry->trackTime;
+        dentry->trackLast                = sentry->trackLast;
+        dentry->nextTrackLast            = sentry->nextTrackLast;
+        dentry->trackEnd                 = sentry->trackEnd;
+        dentry->timeScale                = sentry->timeScale;
+        dentry->alpha                    = sentry->alpha;
+        dentry->mixBlend                 = sentry->mixBlend;
+    }
+}
+
+// Creates the spine instances of a cloned node from the source node.
+// Unlike SetupNode, the pose is copied from the source instead of being computed from the setup pose
+static bool CloneNode(InternalGuiNode* dst, const InternalGuiNode* src)
+{
+    dst->m_SpinePath  = src->m_SpinePath;
+    dst->m_SpineScene = src->m_SpineScene;
+
+    if (!src->m_SkeletonInstance || !src->m_AnimationStateInstance)
+        return false;
+
+    dst->m_SkeletonInstance = spSkeleton_create(dst->m_SpineScene->m_Skeleton);
+    if (!dst->m_SkeletonInstance)
+    {
+        dmLogError("%s: Failed to create skeleton instance", __FUNCTION__);
+        DestroyNode(dst);
+        return false;
+    }
+
+    dst->m_AnimationStateInstance = spAnimationState_create(dst->m_SpineScene->m_AnimationStateData);
+    if (!dst->m_AnimationStateInstance)
+    {
+        dmLogError("%s: Failed to create animation state instance", __FUNCTION__);
+        DestroyNode(dst);
+        return false;
+    }
+
+    dst->m_AnimationStateInstance->userData = dst;
+    dst->m_AnimationStateInstance->listener = SpineEventListener;
+
+    spSkeleton_setSkin(dst->m_SkeletonInstance, src->m_SkeletonInstance->skin);
+    CopySkeletonPose(dst->m_SkeletonInstance, src->m_SkeletonInstance);
+    CopyTracks(dst, src);
+
+    // The pose is identical, so are the bounds
+    dst->m_LocalBounds          = src->m_LocalBounds;
+    dst->m_BoundsDirty          = src->m_BoundsDirty;
+    dst->m_PoseDirty            = src->m_PoseDirty;
+    dst->m_WorldTransformDirty  = src->m_WorldTransformDirty;
+
+    dmGui::SetNodeTexture(dst->m_GuiScene, dst->m_GuiNode, dmGui::NODE_TEXTURE_TYPE_TEXTURE_SET, (dmGui::HTextureSource)dst->m_SpineScene->m_TextureSet);
+    return true;
+}
+
 static void* GuiClone(const dmGameSystem::CompGuiNodeContext* ctx, const dmGameSystem::CustomNodeCtx* nodectx)
 {
     InternalGuiNode* src = (InternalGuiNode*)nodectx->m_NodeData;
@@ -1080,19 +1367,20 @@ static void* GuiClone(const dmGameSystem::CompGuiNodeContext* ctx, const dmGameS
     dst->m_GuiScene = nodectx->m_Scene;
     dst->m_GuiNode = nodectx->m_Node;
     dmSpine::GuiSpineSceneRetain(nodectx->m_Scene);
-    dmSpine::GuiSpineRegisterNode(nodectx->m_Scene, nodectx->m_Node);
+    dmSpine::GuiSpineRegisterNode(nodectx->m_Scene, nodectx->m_Node, &dst->m_SceneNodeIndex);
 
     // We don't get a GuiSetNodeDesc call when cloning, as we should already have the data we need in the node itself
     dst->m_Id = src->m_Id;
     dst->m_AdjustMode = src->m_AdjustMode;
+    dst->m_Clipping = src->m_Clipping;
     dst->m_SkinId = src->m_SkinId;
 
-    // Setup the spine structures
+    // Setup the spine structures, with the same pose and animation state as the source node
     // We don't create bones, as we may be part of a gui.clone_tree, which does the entire subtree, and returns a list of nodes to the user
     // As such, we need to retrieve the child nodes at a later step
     // But, since the cloned nodes doesn't have any id's, we can't fetch them via id
     // So, we instead create specific gui node type for the bones, and let them register themselves to this cloned node
-    SetupNode(src->m_SpinePath, src->m_SpineScene, dst, false);
+    CloneNode(dst, src);
     // Only attempt to find bones on the cloned node if the source node had bones.
     // Avoids unnecessary scanning and array growth when the original had no bones created.
     dst->m_FindBones = src->m_BonesNodes.Size() > 0 ? 1 : 0;
@@ -1102,6 +1390,7 @@ static void* GuiClone(const dmGameSystem::CompGuiNodeContext* ctx, const dmGameS
     dst->m_BonesIds.SetCapacity(num_bones);
     dst->m_BonesNames.SetCapacity(num_bones);
     dst->m_Bones.SetCapacity(num_bones);
+    dst->m_BoneStates.SetCapacity(num_bones);
 
     // Since we cannot get the id's from the gui nodes, we need to copy the data now
     dst->m_BonesIds.SetSize(num_bones);
@@ -1112,49 +1401,8 @@ static void* GuiClone(const dmGameSystem::CompGuiNodeContext* ctx, const dmGameS
 
     // Copy transform
     dst->m_Transform    = src->m_Transform;
-
-    // Copy all tracks from source
-    uint32_t num_tracks = src->m_AnimationTracks.Size();
-    if (num_tracks > 0)
-    {
-        dst->m_AnimationTracks.SetCapacity(num_tracks);
-        dst->m_AnimationTracks.SetSize(num_tracks);
-
-        for (uint32_t i = 0; i < num_tracks; i++)
-        {
-            const GuiSpineAnimationTrack& srcTrack = src->m_AnimationTracks[i];
-            GuiSpineAnimationTrack& dstTrack = dst->m_AnimationTracks[i];
-
-            dstTrack.m_AnimationId = srcTrack.m_AnimationId;
-            dstTrack.m_Playback = srcTrack.m_Playback;
-            dstTrack.m_CallbackInfo = nullptr; // Don't copy callbacks
-            dstTrack.m_CallbackId = 0;
-            dstTrack.m_AnimationInstance = nullptr;
-
-            if (srcTrack.m_AnimationId && srcTrack.m_AnimationInstance)
-            {
-                uint32_t index = FindAnimationIndex(dst, srcTrack.m_AnimationId);
-                if (index != INVALID_ANIMATION_INDEX && index < dst->m_SpineScene->m_Skeleton->animationsCount)
-                {
-                    spAnimation* animation = dst->m_SpineScene->m_Skeleton->animations[index];
-                    if (animation)
-                    {
-                        int loop = IsLooping(srcTrack.m_Playback);
-                        dstTrack.m_AnimationInstance = spAnimationState_setAnimation(dst->m_AnimationStateInstance, i, animation, loop);
-
-                        // Copy the state of the animation
-                        if (dstTrack.m_AnimationInstance)
-                        {
-                            dstTrack.m_AnimationInstance->trackTime = srcTrack.m_AnimationInstance->trackTime;
-                            dstTrack.m_AnimationInstance->reverse = srcTrack.m_AnimationInstance->reverse;
-                            dstTrack.m_AnimationInstance->timeScale = srcTrack.m_AnimationInstance->timeScale;
-                        }
-                    }
-                }
-            }
-        }
-    }
-
+    dst->m_CullRect     = src->m_CullRect;
+    dst->m_UseCullRect  = src->m_UseCullRect;
 
     return dst;
 }
@@ -1182,6 +1430,7 @@ static void GuiSetNodeDesc(const dmGameSystem::CompGuiNodeContext* ctx, const dm
 
     node->m_Id = node_desc->m_Id;
     node->m_AdjustMode = (dmGui::AdjustMode)node_desc->m_AdjustMode;
+    node->m_Clipping = node_desc->m_ClippingMode != dmGuiDDF::NodeDesc::CLIPPING_MODE_NONE;
 
     SetupNode(name_hash, resource, node, create_bones);
 
@@ -1194,6 +1443,162 @@ static void GuiSetNodeDesc(const dmGameSystem::CompGuiNodeContext* ctx, const dm
     }
 }
 
+// Returns true if the node's local bounds, transformed by the node's position, rotation and scale,
+// end up completely outside the cull rect (both given in the parent node space)
+static bool IsOutsideCullRect(InternalGuiNode* node)
+{
+    const SpineModelBounds& b = node->m_LocalBounds;
+    dmVMath::Vector4 position = dmGui::GetNodeProperty(node->m_GuiScene, node->m_GuiNode, dmGui::PROPERTY_POSITION);
+    dmVMath::Vector4 scale = dmGui::GetNodeProperty(node->m_GuiScene, node->m_GuiNode, dmGui::PROPERTY_SCALE);
+    dmVMath::Vector4 euler = dmGui::GetNodeProperty(node->m_GuiScene, node->m_GuiNode, dmGui::PROPERTY_EULER);
+
+    float angle = euler.getZ() * (M_PI / 180.0f);
+    float c = cosf(angle);
+    float s = sinf(angle);
+    float sx = scale.getX();
+    float sy = scale.getY();
+
+    const float corners[4][2] = { {b.minX, b.minY}, {b.maxX, b.minY}, {b.minX, b.maxY}, {b.maxX, b.maxY} };
+    float min_x = FLT_MAX, min_y = FLT_MAX, max_x = -FLT_MAX, max_y = -FLT_MAX;
+    for (int i = 0; i < 4; ++i)
+    {
+        float x = corners[i][0] * sx;
+        float y = corners[i][1] * sy;
+        float px = position.getX() + x * c - y * s;
+        float py = position.getY() + x * s + y * c;
+        min_x = dmMath::Min(min_x, px);
+        min_y = dmMath::Min(min_y, py);
+        max_x = dmMath::Max(max_x, px);
+        max_y = dmMath::Max(max_y, py);
+    }
+
+    const dmVMath::Vector4& r = node->m_CullRect;
+    return max_x < r.getX() || min_x > r.getX() + r.getZ() ||
+           max_y < r.getY() || min_y > r.getY() + r.getW();
+}
+
+// Returns true if any slot has a region or mesh attachment that isn't fully transparent
+static bool HasVisibleAttachments(const spSkeleton* skeleton)
+{
+    if (skeleton->color.a <= 0.0f)
+        return false;
+
+    for (int i = 0; i < skeleton->slotsCount; ++i)
+    {
+        const spSlot* slot = skeleton->slots[i];
+        const spAttachment* attachment = slot->attachment;
+        if (!attachment || !slot->bone->active || slot->color.a <= 0.0f)
+            continue;
+        if (attachment->type == SP_ATTACHMENT_REGION || attachment->type == SP_ATTACHMENT_MESH)
+            return true;
+    }
+    return false;
+}
+
+// Disabled nodes (and nodes under disabled parents) are never passed to us by the gui renderer,
+// so we only need to handle the cases it cannot see: nothing to draw, fully transparent, or outside the cull rect
+static bool IsNodeCulled(GuiNodeTypeContext* type_context, InternalGuiNode* node)
+{
+    dmVMath::Vector4 color = dmGui::GetNodeProperty(node->m_GuiScene, node->m_GuiNode, dmGui::PROPERTY_COLOR);
+    if (color.getW() <= 0.0f)
+        return true;
+
+    // The node was hidden during the last update, and only had its animation time advanced
+    if (node->m_WorldTransformDirty)
+    {
+        node->m_WorldTransformDirty = 0;
+        spSkeleton_updateWorldTransform(node->m_SkeletonInstance, SP_PHYSICS_NONE);
+        node->m_BoundsDirty = 1;
+    }
+
+    if (!HasVisibleAttachments(node->m_SkeletonInstance))
+        return true;
+
+    if (!node->m_UseCullRect)
+        return false;
+
+    // The bounds need a pass over all attachment vertices, so they're only computed when there is a cull rect to test against
+    if (node->m_BoundsDirty)
+    {
+        node->m_BoundsDirty = 0;
+        dmSpine::GetSkeletonBounds(node->m_SkeletonInstance, node->m_LocalBounds, type_context->m_BoundsScratch);
+    }
+
+    if (node->m_LocalBounds.minX > node->m_LocalBounds.maxX) // no attachments at all
+        return true;
+
+    return IsOutsideCullRect(node);
+}
+
+// Maps a spine slot blend mode to the gui blend mode that it corresponds to
+static dmGui::BlendMode SpineBlendModeToGuiBlendMode(spBlendMode blend_mode)
+{
+    switch (blend_mode)
+    {
+        case SP_BLEND_MODE_ADDITIVE:    return dmGui::BLEND_MODE_ADD;
+        case SP_BLEND_MODE_MULTIPLY:    return dmGui::BLEND_MODE_MULT;
+        case SP_BLEND_MODE_SCREEN:      return dmGui::BLEND_MODE_SCREEN;
+        default:                        return dmGui::BLEND_MODE_ALPHA;
+    }
+}
+
+// The gui draws all vertices of a node with the node's blend mode, so slots with a different blend mode are
+// forced to it. That keeps each spine node a single draw, and consecutive spine nodes sharing an atlas in one batch.
+static uint32_t CountSlotBlendOverrides(const InternalGuiNode* node, dmGui::BlendMode blend_mode)
+{
+    const spSkeleton* skeleton = node->m_SkeletonInstance;
+    uint32_t count = 0;
+    for (int i = 0; i < skeleton->slotsCount; ++i)
+    {
+        const spSlot* slot = skeleton->drawOrder[i];
+        if (slot->attachment && slot->bone->active && SpineBlendModeToGuiBlendMode(slot->data->blendMode) != blend_mode)
+            ++count;
+    }
+    return count;
+}
+
+// Counts the vertices and nodes drawn, and why a spine node can't be batched with the previous one.
+// Only spine nodes are seen here, so other nodes drawn in between may break the batch as well
+static void UpdateBatchStats(GuiNodeTypeContext* type_context, const InternalGuiNode* node, uint32_t num_vertices)
+{
+    GuiSpineStats* stats = GuiSpineGetFrameStats(node->m_GuiScene);
+    void* texture = node->m_SpineScene->m_TextureSet;
+
+    stats->m_Nodes++;
+    stats->m_Vertices += num_vertices;
+    DM_PROPERTY_ADD_U32(rmtp_SpineGuiNodesRendered, 1);
+    DM_PROPERTY_ADD_U32(rmtp_SpineGuiVertexCount, num_vertices);
+
+    // Read from the node when rendering, since scripts may change it with gui.set_blend_mode()
+    dmGui::BlendMode blend_mode = dmGui::GetNodeBlendMode(node->m_GuiScene, node->m_GuiNode);
+    uint32_t slot_blend_overrides = CountSlotBlendOverrides(node, blend_mode);
+    stats->m_SlotBlendOverrides += slot_blend_overrides;
+    DM_PROPERTY_ADD_U32(rmtp_SpineGuiSlotBlendOverrides, slot_blend_overrides);
+
+    if (type_context->m_BatchScene == node->m_GuiScene)
+    {
+        if (node->m_Clipping)
+        {
+            stats->m_BatchBreakClipping++;
+            DM_PROPERTY_ADD_U32(rmtp_SpineGuiBatchBreakClipping, 1);
+        }
+        else if (type_context->m_BatchTexture != texture)
+        {
+            stats->m_BatchBreakTexture++;
+            DM_PROPERTY_ADD_U32(rmtp_SpineGuiBatchBreakTexture, 1);
+        }
+        else if (type_context->m_BatchBlendMode != (uint32_t)blend_mode)
+        {
+            stats->m_BatchBreakBlendMode++;
+            DM_PROPERTY_ADD_U32(rmtp_SpineGuiBatchBreakBlendMode, 1);
+        }
+    }
+
+    type_context->m_BatchScene     = node->m_GuiScene;
+    type_context->m_BatchTexture   = texture;
+    type_context->m_BatchBlendMode = (uint32_t)blend_mode;
+}
+
 static void GuiGetVertices(const dmGameSystem::CustomNodeCtx* nodectx, uint32_t decl_size, dmBuffer::StreamDeclaration* decl, uint32_t struct_size, dmArray<uint8_t>& vertices)
 {
     InternalGuiNode* node = (InternalGuiNode*) nodectx->m_NodeData;
@@ -1211,12 +1616,20 @@ static void GuiGetVertices(const dmGameSystem::CustomNodeCtx* nodectx, uint32_t
     // We currently know it's xyz-uv-rgba
     dmArray<dmSpine::GuiSpineVertex>* vbdata = (dmArray<dmSpine::GuiSpineVertex>*)&vertices;
 
-    uint32_t num_vertices = dmSpine::GenerateVertexData(*vbdata, node->m_SkeletonInstance, type_context->m_SkeletonClipper, node->m_Transform, dmVMath::Vector4(1.0f), 0);
-    (void)num_vertices;
+    if (IsNodeCulled(type_context, node))
+    {
+        DM_PROPERTY_ADD_U32(rmtp_SpineGuiNodesCulled, 1);
+        return;
+    }
+    node->m_Rendered = 1;
+
+    uint32_t num_vertices = dmSpine::GenerateVertexData(*vbdata, node->m_SkeletonInstance, type_context->m_SkeletonClipper, node->m_Transform, dmVMath::Vector4(1.0f), 0, type_context->m_PositionScratch);
+    UpdateBatchStats(type_context, node, num_vertices);
 }
 
 // IK functions for GUI spine nodes
-static void ApplyIKTargets(InternalGuiNode* node)
+// Returns true if any constraint target was moved
+static bool ApplyIKTargets(InternalGuiNode* node)
 {
     // Apply node-based targets (following GUI nodes)
     uint32_t count = node->m_IKTargets.Size();
@@ -1232,8 +1645,11 @@ static void ApplyIKTargets(InternalGuiNode* node)
         }
     }
 
+    bool changed = count > 0;
+
     // Apply position-based targets (fixed positions)
     count = node->m_IKTargetPositions.Size();
+    changed |= count > 0;
     for (uint32_t i = 0; i < count; ++i)
     {
         const GuiIKTarget& target = node->m_IKTargetPositions[i];
@@ -1246,12 +1662,17 @@ static void ApplyIKTargets(InternalGuiNode* node)
     }
     // Clear the position-based targets after applying them (they're one-shot)
     node->m_IKTargetPositions.SetSize(0);
+    return changed;
 }
 
 static void GuiUpdate(const dmGameSystem::CustomNodeCtx* nodectx, float dt)
 {
     InternalGuiNode* node = (InternalGuiNode*)(nodectx->m_NodeData);
 
+    // A new frame is about to be rendered, so the next spine node drawn starts a batch
+    GuiNodeTypeContext* type_context = (GuiNodeTypeContext*) nodectx->m_TypeContext;
+    type_context->m_BatchScene = 0;
+
 // Temp fix begin!
     // since the comp_gui.cpp call dmGui::SetNodeTexture() with a null texture, we set it here again
     // Remove once the bug fix is in Defold 1.3.4
@@ -1283,20 +1704,43 @@ static void GuiUpdate(const dmGameSystem::CustomNodeCtx* nodectx, float dt)
         }
     }
 
+    // Nodes that weren't rendered last frame (disabled, fully transparent or culled) only advance their
+    // animation time, so that events and completion callbacks still fire. Bone nodes may be visible on their own,
+    // so nodes with bones are always evaluated.
+    bool visible = node->m_Rendered || node->m_BonesNodes.Size() > 0;
+    node->m_Rendered = 0;
+
     if (anyTrackPlaying)
     {
         spAnimationState_update(node->m_AnimationStateInstance, anim_dt);
         spAnimationState_apply(node->m_AnimationStateInstance, node->m_SkeletonInstance);
         spSkeleton_update(node->m_SkeletonInstance, anim_dt);
+        if (!visible)
+        {
+            node->m_WorldTransformDirty = 1;
+            return;
+        }
         spSkeleton_updateWorldTransform(node->m_SkeletonInstance, SP_PHYSICS_UPDATE);
     }
-    else
+    else if (node->m_PoseDirty || node->m_IKTargets.Size() > 0)
     {
+        if (!visible)
+        {
+            node->m_WorldTransformDirty = 1;
+            return;
+        }
         spSkeleton_updateWorldTransform(node->m_SkeletonInstance, SP_PHYSICS_NONE);
     }
+    else
+    {
+        // Idle, and nothing changed since the last world transform update
+        return;
+    }
+    node->m_WorldTransformDirty = 0;
+    node->m_BoundsDirty = 1;
 
-    // Apply IK targets
-    ApplyIKTargets(node);
+    // Apply IK targets, they take effect on the next world transform update
+    node->m_PoseDirty = ApplyIKTargets(node);
 
     DM_PROPERTY_ADD_U32(rmtp_SpineGuiNodes, 1);
     UpdateBones(node);
@@ -1307,6 +1751,9 @@ static dmGameObject::Result GuiNodeTypeSpineCreate(const dmGameSystem::CompGuiNo
     GuiNodeTypeContext* type_context = new GuiNodeTypeContext;
 
     type_context->m_SkeletonClipper = spSkeletonClipping_create();
+    type_context->m_BatchScene = 0;
+    type_context->m_BatchTexture = 0;
+    type_context->m_BatchBlendMode = 0;
 
     dmGameSystem::CompGuiNodeTypeSetContext(type, type_context);
 
@@ -1359,6 +1806,7 @@ bool SetIKTargetPosition(dmGui::HScene scene, dmGui::HNode hnode, dmhash_t const
     target.m_TargetNode = dmGui::INVALID_HANDLE;
     target.m_Position = position;
     node->m_IKTargetPositions.Push(target);
+    node->m_PoseDirty = 1;
 
     return true;
 }
@@ -1406,6 +1854,7 @@ bool ResetIKTarget(dmGui::HScene scene, dmGui::HNode hnode, dmhash_t constraint_
         if (constraint_id == node->m_IKTargetPositions[i].m_ConstraintHash)
         {
             node->m_IKTargetPositions.EraseSwap(i);
+            node->m_PoseDirty = 1;
             return true;
         }
     }
@@ -1416,6 +1865,7 @@ bool ResetIKTarget(dmGui::HScene scene, dmGui::HNode hnode, dmhash_t constraint_
         if (constraint_id == node->m_IKTargets[i].m_ConstraintHash)
         {
             node->m_IKTargets.EraseSwap(i);
+            node->m_PoseDirty = 1;
             return true;
         }
     }
@@ -1423,6 +1873,14 @@ bool ResetIKTarget(dmGui::HScene scene, dmGui::HNode hnode, dmhash_t constraint_
     return false;
 }
 
+void SetCullRect(dmGui::HScene scene, dmGui::HNode hnode, const dmVMath::Vector4* rect)
+{
+    InternalGuiNode* node = (InternalGuiNode*)dmGui::GetNodeCustomData(scene, hnode);
+    node->m_UseCullRect = rect != 0;
+    if (rect)
+        node->m_CullRect = *rect;
+}
+
 } // namespace
 
 DM_DECLARE_COMPGUI_NODE_TYPE(ComponentTypeGuiNodeSpineModelExt, "Spine", dmSpine::GuiNodeTypeSpineCreate, dmSpine::GuiNodeTypeSpineDestroy)
@@ -69,6 +69,9 @@ bool        SetIKTargetPosition(dmGui::HScene scene, dmGui::HNode hnode, dmhash_
 bool        SetIKTarget(dmGui::HScene scene, dmGui::HNode hnode, dmhash_t constraint_id, dmGui::HNode target_node);
 bool        ResetIKTarget(dmGui::HScene scene, dmGui::HNode hnode, dmhash_t constraint_id);
 
+// Visible area (x, y, width, height) in the parent node space. Pass 0 to disable culling against it.
+void        SetCullRect(dmGui::HScene scene, dmGui::HNode hnode, const dmVMath::Vector4* rect);
+
 } // namespace
 
 
@@ -8,6 +8,8 @@
 #include <dmsdk/dlib/array.h>
 #include <dmsdk/dlib/hashtable.h>
 
+#include <string.h> // memset
+
 // Local includes
 #include "spine_gui_common.h"
 #include "res_spine_scene.h"
@@ -23,7 +25,18 @@ namespace dmSpine {
 
     static dmHashTable64<SceneOverrides*> g_SceneOverrides; // (scene_ptr) -> SceneOverrides*
     static dmHashTable64<uint32_t>        g_SceneRefcounts; // (scene_ptr) -> count
-    static dmHashTable64< dmArray<dmGui::HNode>* > g_SceneNodes; // (scene_ptr) -> list of spine gui nodes
+    // A registered node, and where the node stores its position in the list
+    struct SceneNode {
+        dmGui::HNode m_Node;
+        uint32_t*    m_Index;
+    };
+    static dmHashTable64< dmArray<SceneNode>* > g_SceneNodes; // (scene_ptr) -> list of spine gui nodes
+
+    struct SceneStats {
+        GuiSpineStats m_Current;
+        GuiSpineStats m_Last;
+    };
+    static dmHashTable64<SceneStats>      g_SceneStats;     // (scene_ptr) -> stats
     static dmResource::HFactory           g_ResourceFactory = 0x0;
 
 static inline uint64_t SceneKey(dmGui::HScene scene) {
@@ -73,12 +86,12 @@ static dmGameObject::PropertyResult CompSpineGuiSetProperty(dmGui::HScene scene,
         return pres;
 
     // Propagate the override to any existing nodes in this scene using the same alias
-    dmArray<dmGui::HNode>** nodes_ptr = g_SceneNodes.Get(skey);
+    dmArray<SceneNode>** nodes_ptr = g_SceneNodes.Get(skey);
     if (nodes_ptr) {
-        dmArray<dmGui::HNode>& nodes = **nodes_ptr;
+        dmArray<SceneNode>& nodes = **nodes_ptr;
         const uint32_t n = nodes.Size();
         for (uint32_t i = 0; i < n; ++i) {
-            dmGui::HNode hnode = nodes[i];
+            dmGui::HNode hnode = nodes[i].m_Node;
             // if an existing node already use a spine scene with this alias, we need to re-set it,
             // since now it's a new spine scene in this slot/alias
             if (dmSpine::GetScene(scene, hnode) == name_hash) {
@@ -140,19 +153,18 @@ void GuiSpineInitialize(dmResource::HFactory resource_factory)
     {
         g_SceneNodes.SetCapacity(4, 8);
     }
+    if (g_SceneStats.Capacity() == 0)
+    {
+        g_SceneStats.SetCapacity(4, 8);
+    }
 
     // Register per-property handlers for GUI spine_scene property
     dmGameSystem::CompGuiRegisterSetPropertyFn(SPINE_SCENE, CompSpineGuiSetProperty);
     dmGameSystem::CompGuiRegisterGetPropertyFn(SPINE_SCENE, CompSpineGuiGetProperty);
 }
 
-static void CleanupSceneOverrides(dmGui::HScene scene)
+static void ReleaseSceneOverrides(SceneOverrides* scene_bucket)
 {
-    SceneOverrides** scene_bucket_ptr = g_SceneOverrides.Get(SceneKey(scene));
-    if (!scene_bucket_ptr)
-        return;
-    SceneOverrides* scene_bucket = *scene_bucket_ptr;
-
     // Release all held resources
     for (uint32_t i = 0; i < scene_bucket->m_Keys.Size(); ++i) {
         dmhash_t key = scene_bucket->m_Keys[i];
@@ -162,24 +174,44 @@ static void CleanupSceneOverrides(dmGui::HScene scene)
             *slot = 0;
         }
     }
+    delete scene_bucket;
+}
 
-    // Remove from map and delete bucket
+static void CleanupSceneOverrides(dmGui::HScene scene)
+{
     uint64_t skey = SceneKey(scene);
+    SceneOverrides** scene_bucket_ptr = g_SceneOverrides.Get(skey);
+    if (!scene_bucket_ptr)
+        return;
+    SceneOverrides* scene_bucket = *scene_bucket_ptr;
+
+    // Remove from map and delete bucket
     g_SceneOverrides.Erase(skey);
-    delete scene_bucket;
+    ReleaseSceneOverrides(scene_bucket);
 }
 
 static void CleanupSceneNodes(dmGui::HScene scene)
 {
     uint64_t skey = SceneKey(scene);
-    dmArray<dmGui::HNode>** nodes_ptr = g_SceneNodes.Get(skey);
+    dmArray<SceneNode>** nodes_ptr = g_SceneNodes.Get(skey);
     if (!nodes_ptr)
         return;
-    dmArray<dmGui::HNode>* nodes = *nodes_ptr;
+    // Any nodes still registered are going away with the scene, so the whole list is dropped at once
+    dmArray<SceneNode>* nodes = *nodes_ptr;
     delete nodes;
     g_SceneNodes.Erase(skey);
 }
 
+static void DeleteSceneOverridesIter(void*, const uint64_t*, SceneOverrides** scene_bucket)
+{
+    ReleaseSceneOverrides(*scene_bucket);
+}
+
+static void DeleteSceneNodesIter(void*, const uint64_t*, dmArray<SceneNode>** nodes)
+{
+    delete *nodes;
+}
+
 void GuiSpineSceneRetain(dmGui::HScene scene)
 {
     uint64_t skey = SceneKey(scene);
@@ -208,6 +240,7 @@ void GuiSpineSceneRelease(dmGui::HScene scene)
     g_SceneRefcounts.Erase(skey);
     CleanupSceneOverrides(scene);
     CleanupSceneNodes(scene);
+    g_SceneStats.Erase(skey);
 }
 
 void GuiSpineFinalize()
@@ -215,19 +248,62 @@ void GuiSpineFinalize()
     // Unregister per-property handlers for GUI spine_scene property
     dmGameSystem::CompGuiUnregisterSetPropertyFn(SPINE_SCENE);
     dmGameSystem::CompGuiUnregisterGetPropertyFn(SPINE_SCENE);
+
+    // Scenes still alive at this point are torn down in bulk
+    g_SceneOverrides.Iterate(DeleteSceneOverridesIter, (void*)0);
+    g_SceneNodes.Iterate(DeleteSceneNodesIter, (void*)0);
     g_ResourceFactory = 0x0;
 
     g_SceneOverrides.Clear();
     g_SceneRefcounts.Clear();
     g_SceneNodes.Clear();
+    g_SceneStats.Clear();
+}
+
+GuiSpineStats* GuiSpineGetFrameStats(dmGui::HScene scene)
+{
+    uint64_t skey = SceneKey(scene);
+    SceneStats* stats = g_SceneStats.Get(skey);
+    if (!stats) {
+        if (g_SceneStats.Full()) {
+            g_SceneStats.OffsetCapacity(8);
+        }
+        SceneStats empty;
+        memset(&empty, 0, sizeof(empty));
+        g_SceneStats.Put(skey, empty);
+        stats = g_SceneStats.Get(skey);
+    }
+    return &stats->m_Current;
 }
 
-void GuiSpineRegisterNode(dmGui::HScene scene, dmGui::HNode node)
+bool GuiSpineGetLastFrameStats(dmGui::HScene scene, GuiSpineStats* out)
+{
+    memset(out, 0, sizeof(*out));
+    if (!g_SceneRefcounts.Get(SceneKey(scene)))
+        return false;
+    SceneStats* stats = g_SceneStats.Get(SceneKey(scene));
+    if (stats)
+        *out = stats->m_Last;
+    return true;
+}
+
+static void CompleteFrameStats(void*, const uint64_t*, SceneStats* stats)
+{
+    stats->m_Last = stats->m_Current;
+    memset(&stats->m_Current, 0, sizeof(stats->m_Current));
+}
+
+void GuiSpineUpdate()
+{
+    g_SceneStats.Iterate(CompleteFrameStats, (void*)0);
+}
+
+void GuiSpineRegisterNode(dmGui::HScene scene, dmGui::HNode node, uint32_t* index)
 {
     uint64_t skey = SceneKey(scene);
-    dmArray<dmGui::HNode>** nodes_ptr = g_SceneNodes.Get(skey);
+    dmArray<SceneNode>** nodes_ptr = g_SceneNodes.Get(skey);
     if (!nodes_ptr) {
-        dmArray<dmGui::HNode>* list = new dmArray<dmGui::HNode>();
+        dmArray<SceneNode>* list = new dmArray<SceneNode>();
         list->SetCapacity(8);
         if (g_SceneNodes.Full()) {
             g_SceneNodes.OffsetCapacity(8);
@@ -235,19 +311,34 @@ void GuiSpineRegisterNode(dmGui::HScene scene, dmGui::HNode node)
         g_SceneNodes.Put(skey, list);
         nodes_ptr = g_SceneNodes.Get(skey);
     }
-    dmArray<dmGui::HNode>* nodes = *nodes_ptr;
-    if (nodes->Full()) nodes->OffsetCapacity(16);
-    nodes->Push(node);
+    dmArray<SceneNode>* nodes = *nodes_ptr;
+    if (nodes->Full()) {
+        // Grow geometrically, as scenes may clone hundreds of nodes in one go
+        uint32_t capacity = nodes->Capacity();
+        nodes->OffsetCapacity(capacity < 16 ? 16 : capacity);
+    }
+    *index = nodes->Size();
+    SceneNode entry;
+    entry.m_Node = node;
+    entry.m_Index = index;
+    nodes->Push(entry);
 }
 
-void GuiSpineUnregisterNode(dmGui::HScene scene, dmGui::HNode node)
+void GuiSpineUnregisterNode(dmGui::HScene scene, dmGui::HNode node, uint32_t* index)
 {
-    dmArray<dmGui::HNode>** nodes_ptr = g_SceneNodes.Get(SceneKey(scene));
+    dmArray<SceneNode>** nodes_ptr = g_SceneNodes.Get(SceneKey(scene));
     if (!nodes_ptr) return;
-    dmArray<dmGui::HNode>* nodes = *nodes_ptr;
-    for (uint32_t i = 0; i < nodes->Size(); ++i) {
-        if ((*nodes)[i] == node) { nodes->EraseSwap(i); break; }
+    dmArray<SceneNode>* nodes = *nodes_ptr;
+    uint32_t i = *index;
+    if (i >= nodes->Size() || (*nodes)[i].m_Node != node)
+        return;
+
+    // Swap the last node into the free slot, and let it know where it went
+    nodes->EraseSwap(i);
+    if (i < nodes->Size()) {
+        *(*nodes)[i].m_Index = i;
     }
+    *index = 0xFFFFFFFF;
 }
 
 void* GetResource(dmGui::HScene scene, dmhash_t name_hash, dmhash_t suffix_hash)
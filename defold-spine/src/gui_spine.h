@@ -18,8 +18,28 @@ void GuiSpineSceneRetain(dmGui::HScene scene);
 void GuiSpineSceneRelease(dmGui::HScene scene);
 
 // Register/unregister Spine GUI nodes within a scene (for override propagation)
-void GuiSpineRegisterNode(dmGui::HScene scene, dmGui::HNode node);
-void GuiSpineUnregisterNode(dmGui::HScene scene, dmGui::HNode node);
+// The node keeps its slot in *index, which is kept up to date while registered, so unregistering is constant time
+void GuiSpineRegisterNode(dmGui::HScene scene, dmGui::HNode node, uint32_t* index);
+void GuiSpineUnregisterNode(dmGui::HScene scene, dmGui::HNode node, uint32_t* index);
+
+// Per frame statistics of the Spine nodes in a GUI scene
+struct GuiSpineStats
+{
+    uint32_t m_BoneUpdates;     // Number of bone nodes whose transform was written
+    uint32_t m_Nodes;           // Number of spine nodes rendered
+    uint32_t m_Vertices;        // Number of vertices generated
+    uint32_t m_BatchBreakTexture;   // Number of spine nodes drawn with a different texture than the previous spine node
+    uint32_t m_BatchBreakBlendMode; // Number of spine nodes drawn with a different blend mode than the previous spine node
+    uint32_t m_BatchBreakClipping;  // Number of spine nodes that are clippers, and start a new batch
+    uint32_t m_SlotBlendOverrides;  // Number of slots drawn with the node blend mode instead of their own
+};
+
+// Statistics of the frame in progress, for the nodes to accumulate into
+GuiSpineStats* GuiSpineGetFrameStats(dmGui::HScene scene);
+// Statistics of the last completed frame. Returns false if the scene has no Spine nodes
+bool GuiSpineGetLastFrameStats(dmGui::HScene scene, GuiSpineStats* out);
+// Called once per frame to complete the statistics of all scenes
+void GuiSpineUpdate();
 
 // Resource lookup wrapper for GUI: checks local overrides for spinescenec, then falls back
 void* GetResource(dmGui::HScene scene, dmhash_t name_hash, dmhash_t suffix_hash);
@@ -14,6 +14,8 @@
 
 namespace dmSpine
 {
+    // Note: The spine scenes don't use this resource type, but read the data file directly instead,
+    // to avoid keeping this copy around while parsing (see LoadSkeletonData in res_spine_scene.cpp)
     static SpineDataResource* CreateResource(const void* buffer, uint32_t buffer_size)
     {
         SpineDataResource* resource = new SpineDataResource;
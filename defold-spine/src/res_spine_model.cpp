@@ -1,10 +1,42 @@
 #include "res_spine_model.h"
 
 #include <dmsdk/dlib/log.h>
+#include <dmsdk/dlib/hash.h>
 #include <dmsdk/resource/resource.h>
 
 namespace dmSpine
 {
+    // Parses the comma separated bone names, ignoring surrounding whitespace and empty entries
+    static void ParseGoBones(const char* bones, dmArray<dmhash_t>& out)
+    {
+        out.SetSize(0);
+        if (!bones)
+            return;
+
+        const char* cursor = bones;
+        while (*cursor)
+        {
+            while (*cursor == ' ' || *cursor == '\t')
+                ++cursor;
+            const char* start = cursor;
+            while (*cursor && *cursor != ',')
+                ++cursor;
+            const char* end = cursor;
+            while (end > start && (end[-1] == ' ' || end[-1] == '\t'))
+                --end;
+
+            if (end > start)
+            {
+                if (out.Full())
+                    out.OffsetCapacity(4);
+                out.Push(dmHashBuffer64(start, (uint32_t)(end - start)));
+            }
+
+            if (*cursor == ',')
+                ++cursor;
+        }
+    }
+
     static dmResource::Result AcquireResources(dmResource::HFactory factory, SpineModelResource* resource, const char* filename)
     {
         dmResource::Result result = dmResource::Get(factory, resource->m_Ddf->m_SpineScene, (void**) &resource->m_SpineScene);
@@ -25,6 +57,7 @@ namespace dmSpine
         }
 
         resource->m_CreateGoBones = resource->m_Ddf->m_CreateGoBones!=0;
+        ParseGoBones(resource->m_Ddf->m_GoBones, resource->m_GoBones);
 
         return dmResource::RESULT_OK;
     }
@@ -2,6 +2,8 @@
 #ifndef DM_RES_SPINE_MODEL_H
 #define DM_RES_SPINE_MODEL_H
 
+#include <dmsdk/dlib/array.h>
+#include <dmsdk/dlib/hash.h>
 #include <dmsdk/render/render.h>
 #include <dmsdk/gamesys/resources/res_rig_scene.h>
 #include <dmsdk/gamesys/resources/res_material.h>
@@ -17,6 +19,7 @@ namespace dmSpine
         dmGameSystemDDF::SpineModelDesc*    m_Ddf;
         SpineSceneResource*                 m_SpineScene;
         dmGameSystem::MaterialResource*     m_Material;
+        dmArray<dmhash_t>                   m_GoBones;      // Bone names from the go_bones list. Empty means all bones
         uint8_t                             m_CreateGoBones:1;
     };
 }
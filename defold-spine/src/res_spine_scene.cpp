@@ -1,15 +1,21 @@
 #include "res_spine_scene.h"
-#include "res_spine_data.h"
 #include "spine_ddf.h" // generated from the spine_ddf.proto
 
+#include <stdlib.h> // realloc, free
+#include <string.h> // memcpy
+
 #include <common/spine_loader.h>
 
+#include <dmsdk/dlib/hash.h>
 #include <dmsdk/dlib/log.h>
 #include <dmsdk/dlib/math.h>
+#include <dmsdk/dlib/mutex.h>
 #include <dmsdk/resource/resource.h>
 
+#include <spine/Animation.h>
 #include <spine/AnimationStateData.h>
 #include <dmsdk/gamesys/resources/res_textureset.h>
+#include <gamesys/texture_set_ddf.h>
 
 // Also see the guide http://esotericsoftware.com/spine-c#Loading-skeleton-data
 
@@ -21,38 +27,324 @@
 
 namespace dmSpine
 {
+    // Scenes reading the same skeleton file (e.g. with different atlases) share the animations of the first one.
+    // Only the skeleton setup and the attachments are read per scene, since they're bound to the atlas regions.
+    struct SharedAnimations
+    {
+        // Owns the animations. It's kept alive until the last scene is gone, since the borrowed timelines
+        // reference its attachments and event data. Its regions may be gone by then, but they're never used.
+        spSkeletonData* m_Skeleton;
+        dmhash_t        m_DataHash;
+        uint32_t        m_RefCount;
+    };
 
-    static dmResource::Result AcquireResources(dmResource::HFactory factory, SpineSceneResource* resource)
+    // The region table only depends on the atlas, so scenes using the same atlas share it.
+    // The attachments point into the regions, so they're kept until the last scene is gone.
+    struct SharedRegions
     {
-        dmResource::Result result = dmResource::Get(factory, resource->m_Ddf->m_Atlas, (void**) &resource->m_TextureSet); // .atlas -> .texturesetc
-        if (result != dmResource::RESULT_OK)
+        spAtlasRegion*              m_Regions;      // Maps 1:1 with the atlas animations array
+        dmHashTable64<uint32_t>*    m_NameToIndex;
+        dmhash_t                    m_AtlasHash;
+        dmhash_t                    m_RegionsHash;  // See HashRegions(), to detect atlases changed at runtime
+        dmGameSystemDDF::TextureSet* m_CheckedTextureSet; // The live texture set last found to match (main thread only)
+        uint32_t                    m_RefCount;
+        bool                        m_Registered;   // False if the table is private to a scene (e.g. after a hot reload)
+    };
+
+    static dmMutex::HMutex                      g_SharedDataMutex = 0; // Guards both tables
+    static dmHashTable64<SharedAnimations*>     g_SharedAnimations;
+    static dmHashTable64<SharedRegions*>        g_SharedRegions;
+    static dmHashTable64<SpineSceneResource*>   g_PreparedScenes; // Keyed by the spine data path
+    static bool                                 g_LazyAnimations = false;
+
+    static SharedAnimations* AcquireSharedAnimations(dmhash_t data_hash)
+    {
+        DM_MUTEX_SCOPED_LOCK(g_SharedDataMutex);
+        SharedAnimations** shared = g_SharedAnimations.Get(data_hash);
+        if (!shared)
+            return 0;
+        (*shared)->m_RefCount++;
+        return *shared;
+    }
+
+    // Returns 0 if another scene registered the same data while we were reading it
+    static SharedAnimations* RegisterSharedAnimations(dmhash_t data_hash, spSkeletonData* skeleton)
+    {
+        DM_MUTEX_SCOPED_LOCK(g_SharedDataMutex);
+        if (g_SharedAnimations.Get(data_hash))
+            return 0;
+        if (g_SharedAnimations.Full())
         {
-            return result;
+            uint32_t capacity = g_SharedAnimations.Capacity() + 16;
+            g_SharedAnimations.SetCapacity(capacity/2+1, capacity);
         }
+        SharedAnimations* shared = new SharedAnimations;
+        shared->m_Skeleton = skeleton;
+        shared->m_DataHash = data_hash;
+        shared->m_RefCount = 1;
+        g_SharedAnimations.Put(data_hash, shared);
+        return shared;
+    }
 
-        SpineDataResource* spine_data_resource = 0;
-        result = dmResource::Get(factory, resource->m_Ddf->m_SpineJson, (void**) &spine_data_resource);
-        if (result != dmResource::RESULT_OK)
+    static void ReleaseSharedAnimations(SharedAnimations* shared)
+    {
         {
-            return result;
+            DM_MUTEX_SCOPED_LOCK(g_SharedDataMutex);
+            if (--shared->m_RefCount > 0)
+                return;
+            g_SharedAnimations.Erase(shared->m_DataHash);
         }
+        spSkeletonData_dispose(shared->m_Skeleton);
+        delete shared;
+    }
 
-        // Create a 1:1 mapping between animation frames and regions in a format that is spine friendly
-        resource->m_Regions = dmSpine::CreateRegions(resource->m_TextureSet->m_TextureSet);
-        resource->m_AttachmentLoader = dmSpine::CreateAttachmentLoader(resource->m_TextureSet->m_TextureSet, resource->m_Regions);
+    static SharedRegions* AcquireSharedRegions(dmhash_t atlas_hash)
+    {
+        DM_MUTEX_SCOPED_LOCK(g_SharedDataMutex);
+        SharedRegions** shared = g_SharedRegions.Get(atlas_hash);
+        if (!shared)
+            return 0;
+        (*shared)->m_RefCount++;
+        return *shared;
+    }
 
-        // Create the spine resource
-        const char* spine_data_path = resource->m_Ddf->m_SpineJson;
-        resource->m_Skeleton = dmSpine::ReadSkeletonData((spAttachmentLoader*)resource->m_AttachmentLoader,
-                                                        spine_data_path,
-                                                        spine_data_resource->m_Data,
-                                                        spine_data_resource->m_Length);
-        dmResource::Release(factory, spine_data_resource);
+    // If register is set, and another scene registered the same atlas while we were creating the table, that one is used instead
+    static SharedRegions* CreateSharedRegions(dmhash_t atlas_hash, dmGameSystemDDF::TextureSet* texture_set_ddf, bool register_regions)
+    {
+        SharedRegions* shared = new SharedRegions;
+        shared->m_Regions = dmSpine::CreateRegions(texture_set_ddf);
+        shared->m_NameToIndex = dmSpine::CreateRegionNameToIndex(texture_set_ddf);
+        shared->m_AtlasHash = atlas_hash;
+        shared->m_RegionsHash = dmSpine::HashRegions(texture_set_ddf);
+        shared->m_CheckedTextureSet = 0;
+        shared->m_RefCount = 1;
+        shared->m_Registered = false;
+        if (!register_regions)
+            return shared;
+
+        DM_MUTEX_SCOPED_LOCK(g_SharedDataMutex);
+        SharedRegions** existing = g_SharedRegions.Get(atlas_hash);
+        if (existing && (*existing)->m_RegionsHash != shared->m_RegionsHash)
+        {
+            // The atlas was changed at runtime (e.g. resource.set_atlas), so the old table isn't handed out anymore
+            (*existing)->m_Registered = false;
+            g_SharedRegions.Erase(atlas_hash);
+            existing = 0;
+        }
+        if (existing)
+        {
+            (*existing)->m_RefCount++;
+            delete[] shared->m_Regions;
+            delete shared->m_NameToIndex;
+            delete shared;
+            return *existing;
+        }
+        if (g_SharedRegions.Full())
+        {
+            uint32_t capacity = g_SharedRegions.Capacity() + 16;
+            g_SharedRegions.SetCapacity(capacity/2+1, capacity);
+        }
+        shared->m_Registered = true;
+        g_SharedRegions.Put(atlas_hash, shared);
+        return shared;
+    }
+
+    // The atlas was reloaded, so scenes created from now on must not use the old table
+    static void UnregisterSharedRegions(dmhash_t atlas_hash)
+    {
+        DM_MUTEX_SCOPED_LOCK(g_SharedDataMutex);
+        SharedRegions** shared = g_SharedRegions.Get(atlas_hash);
+        if (!shared)
+            return;
+        (*shared)->m_Registered = false;
+        g_SharedRegions.Erase(atlas_hash);
+    }
+
+    static void ReleaseSharedRegions(SharedRegions* shared)
+    {
+        {
+            DM_MUTEX_SCOPED_LOCK(g_SharedDataMutex);
+            if (--shared->m_RefCount > 0)
+                return;
+            if (shared->m_Registered)
+                g_SharedRegions.Erase(shared->m_AtlasHash);
+        }
+        delete[] shared->m_Regions;
+        delete shared->m_NameToIndex;
+        delete shared;
+    }
+
+    // Uses the skeleton precompiled by bob (see dmSpine::LoadSkeletonBlob), unless it was made for another runtime or
+    // other atlas regions. The pointers are relocated in place in the ddf, which is kept until the skeleton is released.
+    static bool LoadPrecompiledSkeleton(SpineSceneResource* resource)
+    {
+        if (!resource->m_Ddf || resource->m_Ddf->m_PrecompiledSkeleton.m_Count == 0)
+            return false;
+
+        void* blob = resource->m_Ddf->m_PrecompiledSkeleton.m_Data;
+        uint32_t blob_size = resource->m_Ddf->m_PrecompiledSkeleton.m_Count;
+
+        // The ddf doesn't align the bytes fields
+        void* blob_copy = 0;
+        if (((uintptr_t)blob & 7) != 0)
+        {
+            blob_copy = malloc(blob_size);
+            if (!blob_copy)
+                return false;
+            memcpy(blob_copy, blob, blob_size);
+            blob = blob_copy;
+        }
+
+        resource->m_Skeleton = dmSpine::LoadSkeletonBlob(blob, blob_size, resource->m_Regions->m_RegionsHash);
         if (!resource->m_Skeleton)
         {
+            dmLogDebug("The precompiled skeleton of %s doesn't match this runtime or atlas", resource->m_Ddf->m_SpineJson);
+            free(blob_copy);
+            return false;
+        }
+        resource->m_PrecompiledSkeleton = true;
+        resource->m_PrecompiledSkeletonCopy = blob_copy;
+        return true;
+    }
+
+    // We read the skeleton file into a buffer we own and parse it from there, instead of going through
+    // the SpineDataResource type, which would hold a second copy of the file until the parsing is done.
+    // The buffer is freed as soon as the spSkeletonData exists.
+    // If data is set (malloc'ed), it's used instead of reading the file, and ownership is taken.
+    static dmResource::Result LoadSkeletonData(dmResource::HFactory factory, SpineSceneResource* resource, const char* spine_data_path, void* data, uint32_t data_size)
+    {
+        if (!data && LoadPrecompiledSkeleton(resource))
+            return dmResource::RESULT_OK;
+
+        if (!data)
+        {
+            dmResource::Result result = dmResource::GetRaw(factory, spine_data_path, &data, &data_size);
+            if (result != dmResource::RESULT_OK)
+            {
+                dmLogError("Failed to load spine data %s: %d", spine_data_path, result);
+                return result;
+            }
+        }
+
+        // The binary format is read straight from the buffer, while the json parser needs a null terminated string.
+        // The realloc is usually done in place.
+        if (!dmSpine::IsBinarySkeletonPath(spine_data_path))
+        {
+            char* json_data = (char*)realloc(data, data_size + 1);
+            if (!json_data)
+            {
+                free(data);
+                return dmResource::RESULT_OUT_OF_RESOURCES;
+            }
+            json_data[data_size] = 0;
+            data = json_data;
+        }
+
+        spAttachmentLoader* loader = (spAttachmentLoader*)resource->m_AttachmentLoader;
+
+        // Lazily loaded animations are decoded from the data we keep, and aren't shared
+        if (g_LazyAnimations && dmSpine::IsBinarySkeletonPath(spine_data_path))
+        {
+            resource->m_Skeleton = dmSpine::ReadSkeletonData(loader, spine_data_path, data, data_size, dmSpine::READ_ANIMATIONS_LAZY, &resource->m_AnimationOffsets);
+            resource->m_LazyAnimationCount = resource->m_AnimationOffsets.Size();
+            if (!resource->m_Skeleton || resource->m_LazyAnimationCount == 0)
+            {
+                free(data);
+                resource->m_AnimationOffsets.SetSize(0);
+                resource->m_LazyAnimationCount = 0;
+                return resource->m_Skeleton ? dmResource::RESULT_OK : dmResource::RESULT_INVALID_DATA;
+            }
+            resource->m_SkeletonBinary = data;
+            resource->m_SkeletonBinarySize = data_size;
+            return dmResource::RESULT_OK;
+        }
+
+        // Identical skeleton files share the animations, regardless of path
+        dmhash_t data_hash = dmHashBuffer64(data, data_size);
+        SharedAnimations* shared = AcquireSharedAnimations(data_hash);
+
+        dmSpine::ReadAnimationsMode mode = shared ? dmSpine::READ_ANIMATIONS_NONE : dmSpine::READ_ANIMATIONS_ALL;
+        resource->m_Skeleton = dmSpine::ReadSkeletonData(loader, spine_data_path, data, data_size, mode);
+        free(data);
+
+        if (!resource->m_Skeleton)
+        {
+            if (shared)
+                ReleaseSharedAnimations(shared);
             return dmResource::RESULT_INVALID_DATA;
         }
 
+        if (shared)
+        {
+            dmSpine::BorrowAnimations(resource->m_Skeleton, shared->m_Skeleton);
+        }
+        else if (dmSpine::CanShareAnimations(resource->m_Skeleton))
+        {
+            shared = RegisterSharedAnimations(data_hash, resource->m_Skeleton);
+        }
+        resource->m_SharedAnimations = shared;
+        return dmResource::RESULT_OK;
+    }
+
+    static void FreeSkeletonBinary(SpineSceneResource* resource)
+    {
+        free(resource->m_SkeletonBinary);
+        resource->m_SkeletonBinary = 0;
+        resource->m_SkeletonBinarySize = 0;
+        resource->m_LazyAnimationCount = 0;
+        resource->m_AnimationOffsets.SetSize(0);
+    }
+
+    void SetLazyAnimations(bool lazy)
+    {
+        g_LazyAnimations = lazy;
+    }
+
+    void SetCompactCurves(bool compact)
+    {
+        spCurveTimeline_setCompactCurves(compact ? 1 : 0);
+    }
+
+    spAnimation* ResolveAnimation(SpineSceneResource* resource, uint32_t index)
+    {
+        spAnimation* animation = resource->m_Skeleton->animations[index];
+        if (index >= resource->m_AnimationOffsets.Size() || resource->m_AnimationOffsets[index] == 0)
+            return animation;
+
+        // On failure the error is logged, and the animation stays empty
+        dmSpine::ReadAnimationTimelines((spAttachmentLoader*)resource->m_AttachmentLoader, resource->m_Ddf->m_SpineJson, resource->m_Skeleton,
+                                        resource->m_SkeletonBinary, resource->m_SkeletonBinarySize, resource->m_AnimationOffsets[index], animation);
+        resource->m_AnimationOffsets[index] = 0;
+
+        // The data is no longer needed once all animations are decoded
+        if (--resource->m_LazyAnimationCount == 0)
+            FreeSkeletonBinary(resource);
+        return animation;
+    }
+
+    bool PrefetchAnimation(SpineSceneResource* resource, dmhash_t animation_id)
+    {
+        uint32_t* index = resource->m_AnimationNameToIndex.Get(animation_id);
+        if (!index)
+            return false;
+        ResolveAnimation(resource, *index);
+        return true;
+    }
+
+    // Everything but the texture set resource binding. Only needs the region table,
+    // so that it can be done on the resource loader thread.
+    static dmResource::Result CreateSceneData(dmResource::HFactory factory, SpineSceneResource* resource, const char* spine_data_path, void* data, uint32_t data_size)
+    {
+        SharedRegions* regions = resource->m_Regions;
+        resource->m_AttachmentLoader = dmSpine::CreateAttachmentLoader(regions->m_Regions, regions->m_NameToIndex);
+
+        // Create the spine resource
+        dmResource::Result result = LoadSkeletonData(factory, resource, spine_data_path, data, data_size);
+        if (result != dmResource::RESULT_OK)
+        {
+            return result;
+        }
+
         resource->m_AnimationStateData = spAnimationStateData_create(resource->m_Skeleton);
         //spAnimationStateData_setDefaultMix(resource->m_AnimationStateData, 0.1f); // There's currently no such function!
         resource->m_AnimationStateData->defaultMix = 0.1f; // force mixing
@@ -105,6 +397,17 @@ namespace dmSpine
             }
         }
 
+        {
+            uint32_t count = resource->m_Skeleton->bonesCount;
+            resource->m_BoneNameToIndex.SetCapacity(dmMath::Max(1U, count/3), count);
+            for (int n = 0; n < count; ++n)
+            {
+                dmhash_t name_hash = dmHashString64(resource->m_Skeleton->bones[n]->name);
+                resource->m_BoneNameToIndex.Put(name_hash, n);
+                DEBUGLOG("bone: %d %s", n, resource->m_Skeleton->bones[n]->name);
+            }
+        }
+
         {
             uint32_t count = resource->m_Skeleton->ikConstraintsCount;
             resource->m_IKNameToIndex.SetCapacity(dmMath::Max(1U, count/3), count);
@@ -119,20 +422,190 @@ namespace dmSpine
         return dmResource::RESULT_OK;
     }
 
-    static void ReleaseResources(dmResource::HFactory factory, SpineSceneResource* resource)
+    // Called from the preload, where the texture set resource isn't available yet.
+    // We load our own copy of the texture set ddf, which is only needed while parsing.
+    // Atlases created at runtime have no file to read, and are instead handled in ResourceTypeScene_Create.
+    static dmResource::Result PreloadSceneData(dmResource::HFactory factory, SpineSceneResource* resource)
     {
-        if (resource->m_Ddf)
-            dmDDF::FreeMessage(resource->m_Ddf);
-        if (resource->m_TextureSet)
-            dmResource::Release(factory, resource->m_TextureSet);
+        const char* atlas_path = resource->m_Ddf->m_Atlas;
+        dmhash_t atlas_hash = dmHashString64(atlas_path);
+
+        // Another scene already created the regions for this atlas, so there's no need to read it
+        resource->m_Regions = AcquireSharedRegions(atlas_hash);
+        if (resource->m_Regions)
+            return CreateSceneData(factory, resource, resource->m_Ddf->m_SpineJson, 0, 0);
+
+        void* data = 0;
+        uint32_t data_size = 0;
+        dmResource::Result result = dmResource::GetRaw(factory, atlas_path, &data, &data_size);
+        if (result == dmResource::RESULT_RESOURCE_NOT_FOUND)
+        {
+            return dmResource::RESULT_OK;
+        }
+        if (result != dmResource::RESULT_OK)
+        {
+            dmLogError("Failed to load atlas %s: %d", atlas_path, result);
+            return result;
+        }
 
+        dmGameSystemDDF::TextureSet* texture_set_ddf = 0;
+        dmDDF::Result e = dmDDF::LoadMessage(data, data_size, &dmGameSystemDDF_TextureSet_DESCRIPTOR, (void**) &texture_set_ddf);
+        free(data);
+        if (e != dmDDF::RESULT_OK)
+        {
+            return dmResource::RESULT_DDF_ERROR;
+        }
+
+        // Create a 1:1 mapping between animation frames and regions in a format that is spine friendly.
+        // The regions are copies, so the ddf isn't needed after this.
+        resource->m_Regions = CreateSharedRegions(atlas_hash, texture_set_ddf, true);
+        dmDDF::FreeMessage(texture_set_ddf);
+        return CreateSceneData(factory, resource, resource->m_Ddf->m_SpineJson, 0, 0);
+    }
+
+    // Binds the texture set resource, which is all that's left to do on the main thread
+    static dmResource::Result AcquireTextureSet(dmResource::HFactory factory, SpineSceneResource* resource)
+    {
+        return dmResource::Get(factory, resource->m_Ddf->m_Atlas, (void**) &resource->m_TextureSet); // .atlas -> .texturesetc
+    }
+
+    static dmResource::Result AcquireResources(dmResource::HFactory factory, SpineSceneResource* resource)
+    {
+        dmResource::Result result = AcquireTextureSet(factory, resource);
+        if (result != dmResource::RESULT_OK)
+        {
+            return result;
+        }
+
+        // Only used when reloading, where the atlas may have changed. Scenes still using the old regions keep them,
+        // but the table isn't handed out anymore.
+        dmhash_t atlas_hash = dmHashString64(resource->m_Ddf->m_Atlas);
+        UnregisterSharedRegions(atlas_hash);
+        resource->m_Regions = CreateSharedRegions(atlas_hash, resource->m_TextureSet->m_TextureSet, false);
+        return CreateSceneData(factory, resource, resource->m_Ddf->m_SpineJson, 0, 0);
+    }
+
+    // Everything created by CreateSceneData
+    static void ReleaseSceneData(SpineSceneResource* resource)
+    {
         if (resource->m_AnimationStateData)
             spAnimationStateData_dispose(resource->m_AnimationStateData);
-        if (resource->m_Skeleton)
+        if (resource->m_SharedAnimations)
+        {
+            // The owner of the animations is disposed with the last reference
+            if (resource->m_Skeleton != resource->m_SharedAnimations->m_Skeleton)
+            {
+                dmSpine::ReturnAnimations(resource->m_Skeleton);
+                spSkeletonData_dispose(resource->m_Skeleton);
+            }
+            ReleaseSharedAnimations(resource->m_SharedAnimations);
+            resource->m_SharedAnimations = 0;
+        }
+        else if (resource->m_PrecompiledSkeleton)
+            dmSpine::DisposeSkeletonBlob(resource->m_Skeleton);
+        else if (resource->m_Skeleton)
             spSkeletonData_dispose(resource->m_Skeleton);
+        free(resource->m_PrecompiledSkeletonCopy);
         if (resource->m_AttachmentLoader)
             dmSpine::Dispose(resource->m_AttachmentLoader);
-        delete[] resource->m_Regions;
+        if (resource->m_Regions)
+            ReleaseSharedRegions(resource->m_Regions);
+        resource->m_AnimationStateData = 0;
+        resource->m_Skeleton = 0;
+        resource->m_PrecompiledSkeleton = false;
+        resource->m_PrecompiledSkeletonCopy = 0;
+        resource->m_AttachmentLoader = 0;
+        resource->m_Regions = 0;
+        FreeSkeletonBinary(resource);
+
+        // The names point into the skeleton data
+        resource->m_AnimationNameToIndex.Clear();
+        resource->m_SkinNameToIndex.Clear();
+        resource->m_SlotNameToIndex.Clear();
+        resource->m_BoneNameToIndex.Clear();
+        resource->m_IKNameToIndex.Clear();
+        resource->m_AttachmentHashToName.Clear();
+    }
+
+    static void ReleaseResources(dmResource::HFactory factory, SpineSceneResource* resource)
+    {
+        if (resource->m_TextureSet)
+            dmResource::Release(factory, resource->m_TextureSet);
+        ReleaseSceneData(resource);
+        // A precompiled skeleton lives in the ddf
+        if (resource->m_Ddf)
+            dmDDF::FreeMessage(resource->m_Ddf);
+    }
+
+    SpineSceneResource* NewPreparedSceneResource(const char* atlas_path, dmGameSystemDDF::TextureSet* texture_set_ddf)
+    {
+        dmhash_t atlas_hash = dmHashString64(atlas_path);
+        SpineSceneResource* resource = new SpineSceneResource();
+        resource->m_Regions = AcquireSharedRegions(atlas_hash);
+        if (!resource->m_Regions)
+            resource->m_Regions = CreateSharedRegions(atlas_hash, texture_set_ddf, true);
+        return resource;
+    }
+
+    bool ParsePreparedSceneResource(dmResource::HFactory factory, SpineSceneResource* resource, const char* spine_data_path, void* data, uint32_t data_size)
+    {
+        return CreateSceneData(factory, resource, spine_data_path, data, data_size) == dmResource::RESULT_OK;
+    }
+
+    SpineSceneResource* PrepareSceneResource(dmResource::HFactory factory, const char* atlas_path, dmGameSystemDDF::TextureSet* texture_set_ddf,
+                                                const char* spine_data_path, void* data, uint32_t data_size)
+    {
+        SpineSceneResource* resource = NewPreparedSceneResource(atlas_path, texture_set_ddf);
+        if (!ParsePreparedSceneResource(factory, resource, spine_data_path, data, data_size))
+        {
+            DeletePreparedSceneResource(factory, resource);
+            return 0;
+        }
+        return resource;
+    }
+
+    void AddPreparedSceneResource(dmResource::HFactory factory, const char* spine_data_path, SpineSceneResource* resource)
+    {
+        dmhash_t path_hash = dmHashString64(spine_data_path);
+        SpineSceneResource* previous = 0;
+        {
+            DM_MUTEX_SCOPED_LOCK(g_SharedDataMutex);
+            SpineSceneResource** existing = g_PreparedScenes.Get(path_hash);
+            if (existing)
+                previous = *existing;
+            else if (g_PreparedScenes.Full())
+            {
+                uint32_t capacity = g_PreparedScenes.Capacity() + 16;
+                g_PreparedScenes.SetCapacity(capacity/2+1, capacity);
+            }
+            g_PreparedScenes.Put(path_hash, resource);
+        }
+        if (previous)
+            DeletePreparedSceneResource(factory, previous);
+    }
+
+    static SpineSceneResource* TakePreparedSceneResource(dmhash_t path_hash)
+    {
+        DM_MUTEX_SCOPED_LOCK(g_SharedDataMutex);
+        SpineSceneResource** prepared = g_PreparedScenes.Get(path_hash);
+        if (!prepared)
+            return 0;
+        SpineSceneResource* resource = *prepared;
+        g_PreparedScenes.Erase(path_hash);
+        return resource;
+    }
+
+    void RemovePreparedSceneResource(dmResource::HFactory factory, const char* spine_data_path)
+    {
+        SpineSceneResource* resource = TakePreparedSceneResource(dmHashString64(spine_data_path));
+        if (resource)
+            DeletePreparedSceneResource(factory, resource);
+    }
+
+    void DeletePreparedSceneResource(dmResource::HFactory factory, SpineSceneResource* resource)
+    {
+        ReleaseResources(factory, resource);
+        delete resource;
     }
 
     static dmResource::Result ResourceTypeScene_Preload(const dmResource::ResourcePreloadParams* params)
@@ -144,18 +617,68 @@ namespace dmSpine
             return dmResource::RESULT_DDF_ERROR;
         }
 
-        dmResource::PreloadHint(params->m_HintInfo, ddf->m_SpineJson);
+        // The spine data isn't hinted, since we read it ourselves (see LoadSkeletonData)
         dmResource::PreloadHint(params->m_HintInfo, ddf->m_Atlas);
 
-        *params->m_PreloadData = ddf;
+        // The scene may already have been parsed on a worker (see resource.create_spinescene_async)
+        SpineSceneResource* scene_resource = TakePreparedSceneResource(dmHashString64(ddf->m_SpineJson));
+        if (scene_resource)
+        {
+            if (scene_resource->m_Regions->m_AtlasHash == dmHashString64(ddf->m_Atlas))
+            {
+                scene_resource->m_Ddf = ddf;
+                *params->m_PreloadData = scene_resource;
+                return dmResource::RESULT_OK;
+            }
+            DeletePreparedSceneResource(params->m_Factory, scene_resource);
+        }
+
+        // The preload runs on the resource loader thread, so we do all the parsing here
+        scene_resource = new SpineSceneResource();
+        scene_resource->m_Ddf = ddf;
+        dmResource::Result r = PreloadSceneData(params->m_Factory, scene_resource);
+        if (r != dmResource::RESULT_OK)
+        {
+            ReleaseResources(params->m_Factory, scene_resource);
+            delete scene_resource;
+            return r;
+        }
+
+        *params->m_PreloadData = scene_resource;
         return dmResource::RESULT_OK;
     }
 
     static dmResource::Result ResourceTypeScene_Create(const dmResource::ResourceCreateParams* params)
     {
-        SpineSceneResource* scene_resource = new SpineSceneResource();
-        scene_resource->m_Ddf = (dmGameSystemDDF::SpineSceneDesc*) params->m_PreloadData;
-        dmResource::Result r = AcquireResources(params->m_Factory, scene_resource);
+        SpineSceneResource* scene_resource = (SpineSceneResource*) params->m_PreloadData;
+        dmResource::Result r = AcquireTextureSet(params->m_Factory, scene_resource);
+
+        // The regions were created in the preload from the atlas file, or taken from another scene using the same atlas.
+        // If the atlas has since been replaced at runtime (e.g. with resource.set_atlas), they no longer match the
+        // texture set we got, so the scene data is created again from the live texture set.
+        // The regions are shared, so the atlas is only hashed again when its texture set was replaced.
+        if (r == dmResource::RESULT_OK && scene_resource->m_Skeleton)
+        {
+            dmGameSystemDDF::TextureSet* texture_set_ddf = scene_resource->m_TextureSet->m_TextureSet;
+            SharedRegions* regions = scene_resource->m_Regions;
+            if (regions->m_CheckedTextureSet != texture_set_ddf)
+            {
+                if (regions->m_RegionsHash == dmSpine::HashRegions(texture_set_ddf))
+                    regions->m_CheckedTextureSet = texture_set_ddf;
+                else
+                    ReleaseSceneData(scene_resource);
+            }
+        }
+
+        // The atlas had no file to read in the preload (e.g. created with resource.create_atlas), or it was stale
+        if (r == dmResource::RESULT_OK && !scene_resource->m_Skeleton)
+        {
+            dmhash_t atlas_hash = dmHashString64(scene_resource->m_Ddf->m_Atlas);
+            scene_resource->m_Regions = CreateSharedRegions(atlas_hash, scene_resource->m_TextureSet->m_TextureSet, true);
+            scene_resource->m_Regions->m_CheckedTextureSet = scene_resource->m_TextureSet->m_TextureSet;
+            r = CreateSceneData(params->m_Factory, scene_resource, scene_resource->m_Ddf->m_SpineJson, 0, 0);
+        }
+
         if (r == dmResource::RESULT_OK)
         {
             dmResource::SetResource(params->m_Resource, scene_resource);
@@ -192,6 +715,9 @@ namespace dmSpine
 
     static ResourceResult ResourceTypeScene_Register(HResourceTypeContext ctx, HResourceType type)
     {
+        if (!g_SharedDataMutex)
+            g_SharedDataMutex = dmMutex::New();
+
         return (ResourceResult)dmResource::SetupType(ctx,
                                                    type,
                                                    0, // context
@@ -202,6 +728,14 @@ namespace dmSpine
                                                    ResourceTypeScene_Recreate);
 
     }
+
+    static ResourceResult ResourceTypeScene_Deregister(HResourceTypeContext ctx, HResourceType type)
+    {
+        if (g_SharedDataMutex)
+            dmMutex::Delete(g_SharedDataMutex);
+        g_SharedDataMutex = 0;
+        return (ResourceResult)dmResource::RESULT_OK;
+    }
 }
 
-DM_DECLARE_RESOURCE_TYPE(ResourceTypeSpineSceneExt, "spinescenec", dmSpine::ResourceTypeScene_Register, 0);
+DM_DECLARE_RESOURCE_TYPE(ResourceTypeSpineSceneExt, "spinescenec", dmSpine::ResourceTypeScene_Register, dmSpine::ResourceTypeScene_Deregister);
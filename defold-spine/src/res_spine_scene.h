@@ -1,15 +1,19 @@
 #ifndef DM_RES_SPINE_SCENE_H
 #define DM_RES_SPINE_SCENE_H
 
+#include <dmsdk/dlib/array.h>
+#include <dmsdk/dlib/hash.h>
 #include <dmsdk/dlib/hashtable.h>
+#include <dmsdk/resource/resource.h>
 
-struct spAtlasRegion;
 struct spSkeletonData;
 struct spAnimationStateData;
+struct spAnimation;
 
 namespace dmGameSystemDDF
 {
     struct SpineSceneDesc;
+    struct TextureSet;
 }
 
 namespace dmGameSystem
@@ -20,21 +24,60 @@ namespace dmGameSystem
 namespace dmSpine
 {
     struct spDefoldAtlasAttachmentLoader;
+    struct SharedAnimations;
+    struct SharedRegions;
 
     struct SpineSceneResource
     {
         dmGameSystemDDF::SpineSceneDesc*    m_Ddf;
         dmGameSystem::TextureSetResource*   m_TextureSet;   // The atlas
-        spAtlasRegion*                      m_Regions;      // Maps 1:1 with the atlas animations array
+        SharedRegions*                      m_Regions;      // Shared with the other scenes using the same atlas
         spSkeletonData*                     m_Skeleton;     // the .spinejson or .skel file
+        void*                               m_PrecompiledSkeletonCopy; // Set if the precompiled skeleton had to be copied out of the ddf
+        bool                                m_PrecompiledSkeleton;  // m_Skeleton points into the precompiled skeleton (see dmSpine::LoadSkeletonBlob)
         spAnimationStateData*               m_AnimationStateData;
         spDefoldAtlasAttachmentLoader*      m_AttachmentLoader;
+        SharedAnimations*                   m_SharedAnimations; // Set if the animations are shared with other scenes
+        void*                               m_SkeletonBinary;   // Kept while there are lazily loaded animations left to decode
+        uint32_t                            m_SkeletonBinarySize;
+        uint32_t                            m_LazyAnimationCount;
+        dmArray<uint32_t>                   m_AnimationOffsets; // Offset of each lazily loaded animation in m_SkeletonBinary, 0 once decoded
         dmHashTable64<uint32_t>             m_AnimationNameToIndex;
         dmHashTable64<uint32_t>             m_SkinNameToIndex;
         dmHashTable64<uint32_t>             m_SlotNameToIndex;
+        dmHashTable64<uint32_t>             m_BoneNameToIndex;
         dmHashTable64<uint32_t>             m_IKNameToIndex;
         dmHashTable64<const char*>          m_AttachmentHashToName; // makes it easy for us to do a reverse hash for attachments
     };
+
+    // Set from the game.project setting spine.lazy_animations. Only used for binary skeleton data.
+    void SetLazyAnimations(bool lazy);
+
+    // Set from the game.project setting spine.compact_curves. Affects the spine scenes loaded after the call.
+    void SetCompactCurves(bool compact);
+
+    // Returns the animation, decoding its timelines first if it was loaded lazily
+    spAnimation* ResolveAnimation(SpineSceneResource* resource, uint32_t index);
+
+    // Decodes a lazily loaded animation ahead of playing it. Returns false if there is no such animation.
+    bool PrefetchAnimation(SpineSceneResource* resource, dmhash_t animation_id);
+
+    // Parses a scene ahead of creating the resource.
+    // Takes ownership of the data, which must be allocated with malloc(). Returns 0 on failure.
+    SpineSceneResource* PrepareSceneResource(dmResource::HFactory factory, const char* atlas_path, dmGameSystemDDF::TextureSet* texture_set_ddf,
+                                                const char* spine_data_path, void* data, uint32_t data_size);
+
+    // The same in two steps, so that the parsing can be done on any thread. The regions are copied from the
+    // texture set on the main thread, since the texture set may be replaced at runtime (e.g. resource.set_atlas).
+    SpineSceneResource* NewPreparedSceneResource(const char* atlas_path, dmGameSystemDDF::TextureSet* texture_set_ddf);
+    // Takes ownership of the data, which must be allocated with malloc(). On failure, the resource must still be deleted.
+    bool ParsePreparedSceneResource(dmResource::HFactory factory, SpineSceneResource* resource, const char* spine_data_path, void* data, uint32_t data_size);
+
+    // The next .spinescenec created with this spine data path (and the same atlas) takes the prepared resource instead of parsing the data
+    void AddPreparedSceneResource(dmResource::HFactory factory, const char* spine_data_path, SpineSceneResource* resource);
+    // Deletes a prepared resource that was never used
+    void RemovePreparedSceneResource(dmResource::HFactory factory, const char* spine_data_path);
+    void DeletePreparedSceneResource(dmResource::HFactory factory, SpineSceneResource* resource);
 }
 
 #endif // DM_RES_SPINE_SCENE_H
@@ -17,6 +17,7 @@
 #include "comp_spine_model.h"
 
 #include <dmsdk/sdk.h>
+#include <dmsdk/dlib/buffer.h>
 
 // Not in dmSDK yet
 namespace dmScript
@@ -446,11 +447,49 @@ namespace dmSpine
         return 0;
     }
 
+    /*# decode a spine animation ahead of playing it
+     * When the `spine.lazy_animations` project setting is enabled, the animations of binary
+     * skeletons are decoded the first time they are played. Use this function to decode an
+     * animation up front, e.g. during a loading screen, to avoid the cost when it's first played.
+     * Does nothing if the animation is already decoded.
+     *
+     * @name spine.prefetch_anim
+     * @param url [type:string|hash|url] the spine model using the animation
+     * @param anim_id [type:string|hash] id of the animation to decode
+     * @examples
+     *
+     * The following examples assumes that the spine model has id "spinemodel".
+     *
+     * ```lua
+     * function init(self)
+     *   spine.prefetch_anim("#spinemodel", "jump")
+     *   spine.prefetch_anim("#spinemodel", "death")
+     * end
+     * ```
+     */
+    static int SpineComp_PrefetchAnim(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 0);
+
+        SpineModelComponent* component = 0;
+        dmMessage::URL receiver;
+        dmScript::GetComponentFromLua(L, 1, SPINE_MODEL_EXT, 0, (void**)&component, &receiver);
+
+        dmhash_t anim_id = dmScript::CheckHashOrString(L, 2);
+        if (!CompSpineModelPrefetchAnimation(component, anim_id))
+        {
+            char buffer[128];
+            return DM_LUA_ERROR("the animation '%s' could not be found in component %s", dmHashReverseSafe64(anim_id), dmScript::UrlToString(&receiver, buffer, sizeof(buffer)));
+        }
+        return 0;
+    }
+
     /*# retrieve the game object corresponding to a spine model skeleton bone
      * Returns the id of the game object that corresponds to a specified skeleton bone.
      * The returned game object can be used for parenting and transform queries.
      * This function has complexity `O(n)`, where `n` is the number of bones in the spine model skeleton.
      * Game objects corresponding to a spine model skeleton bone can not be individually deleted.
+     * If the bone is not in the model's "Go Bones" list, its game object is created on the first call.
      *
      * @name spine.get_go
      * @param url [type:string|hash|url] the spine model to query
@@ -489,6 +528,162 @@ namespace dmSpine
         return 1;
     }
 
+    HSpineModel GetSpineModel(lua_State* L, int index)
+    {
+        SpineModelComponent* component = 0;
+        dmMessage::URL receiver;
+        dmScript::GetComponentFromLua(L, index, SPINE_MODEL_EXT, 0, (void**)&component, &receiver);
+        return component;
+    }
+
+    static const dmhash_t BONE_TRANSFORM_STREAM = dmHashString64("transform");
+
+    // Returns the world transform of the bone with the id at the given stack index
+    static Matrix4 CheckBoneTransform(lua_State* L, int index, SpineModelComponent* component)
+    {
+        dmhash_t bone_id = dmScript::CheckHashOrString(L, index);
+        int32_t bone_index = GetBoneIndex(component, bone_id);
+        Matrix4 transform;
+        if (!GetBoneWorldTransforms(component, &bone_index, 1, &transform))
+        {
+            luaL_error(L, "the bone '%s' could not be found", dmHashReverseSafe64(bone_id));
+        }
+        return transform;
+    }
+
+    /*# get the world transforms of spine model bones
+     * Returns the world transforms of one or more bones, as of the last update of the spine model.
+     * Unlike [ref:spine.get_go], this doesn't require the "Create Go Bones" option.
+     *
+     * The results can be written into a preallocated table of `vmath.matrix4`, or into a buffer with a
+     * float32 stream named "transform" with 16 components (a column major matrix) per bone, to avoid
+     * creating garbage every frame.
+     *
+     * @name spine.get_bone_transforms
+     * @param url [type:string|hash|url] the spine model to query
+     * @param bone_ids [type:string|hash|table] a bone id, or a table of bone ids
+     * @param [result] [type:table|buffer] table of `vmath.matrix4` or a buffer to write the transforms into
+     * @return transforms [type:matrix4|table|buffer] the transform if a single bone id was given, otherwise a table of transforms.
+     * If `result` was given, it is returned
+     * @examples
+     *
+     * How to make a particle effect follow the "right_hand" bone:
+     *
+     * ```lua
+     * function init(self)
+     *   self.bones = { hash("right_hand") }
+     *   self.transforms = { vmath.matrix4() }
+     * end
+     *
+     * function late_update(self, dt)
+     *   spine.get_bone_transforms("#spinemodel", self.bones, self.transforms)
+     *   local m = self.transforms[1]
+     *   go.set_position(vmath.vector3(m.m03, m.m13, m.m23), "effect")
+     * end
+     * ```
+     */
+    static int SpineComp_GetBoneTransforms(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 1);
+        int top = lua_gettop(L);
+
+        SpineModelComponent* component = GetSpineModel(L, 1);
+
+        bool is_list = lua_istable(L, 2);
+        uint32_t count = is_list ? (uint32_t)lua_objlen(L, 2) : 1;
+        if (!is_list)
+        {
+            lua_pushvalue(L, 2);
+        }
+
+        if (top > 2 && dmScript::IsBuffer(L, 3))
+        {
+            dmBuffer::HBuffer buffer = dmScript::CheckBufferUnpack(L, 3);
+            float* data = 0;
+            uint32_t stream_count = 0;
+            uint32_t components = 0;
+            uint32_t stride = 0;
+            dmBuffer::ValueType value_type;
+            uint32_t type_components = 0;
+            dmBuffer::Result r = dmBuffer::GetStreamType(buffer, BONE_TRANSFORM_STREAM, &value_type, &type_components);
+            if (r == dmBuffer::RESULT_OK)
+                r = dmBuffer::GetStream(buffer, BONE_TRANSFORM_STREAM, (void**)&data, &stream_count, &components, &stride);
+            if (r != dmBuffer::RESULT_OK || value_type != dmBuffer::VALUE_TYPE_FLOAT32 || components != 16)
+            {
+                return DM_LUA_ERROR("the buffer must have a float32 stream named 'transform' with 16 components");
+            }
+            if (stream_count < count)
+            {
+                return DM_LUA_ERROR("the buffer has room for %u transforms, but %u were requested", stream_count, count);
+            }
+
+            for (uint32_t i = 0; i < count; ++i, data += stride)
+            {
+                if (is_list)
+                    lua_rawgeti(L, 2, i + 1);
+                Matrix4 m = CheckBoneTransform(L, -1, component);
+                lua_pop(L, 1);
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    const Vector4 col = m.getCol(c);
+                    data[c*4 + 0] = col.getX();
+                    data[c*4 + 1] = col.getY();
+                    data[c*4 + 2] = col.getZ();
+                    data[c*4 + 3] = col.getW();
+                }
+            }
+            lua_pushvalue(L, 3);
+            return 1;
+        }
+
+        if (top > 2 && !lua_isnil(L, 3))
+        {
+            luaL_checktype(L, 3, LUA_TTABLE);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                if (is_list)
+                    lua_rawgeti(L, 2, i + 1);
+                Matrix4 m = CheckBoneTransform(L, -1, component);
+                lua_pop(L, 1);
+
+                // Reuse the matrices already in the table
+                lua_rawgeti(L, 3, i + 1);
+                Matrix4* out = lua_isnil(L, -1) ? 0 : dmScript::ToMatrix4(L, -1);
+                lua_pop(L, 1);
+                if (out)
+                {
+                    *out = m;
+                }
+                else
+                {
+                    dmScript::PushMatrix4(L, m);
+                    lua_rawseti(L, 3, i + 1);
+                }
+            }
+            lua_pushvalue(L, 3);
+            return 1;
+        }
+
+        if (!is_list)
+        {
+            Matrix4 m = CheckBoneTransform(L, -1, component);
+            lua_pop(L, 1);
+            dmScript::PushMatrix4(L, m);
+            return 1;
+        }
+
+        lua_createtable(L, count, 0);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            lua_rawgeti(L, 2, i + 1);
+            Matrix4 m = CheckBoneTransform(L, -1, component);
+            lua_pop(L, 1);
+            dmScript::PushMatrix4(L, m);
+            lua_rawseti(L, -2, i + 1);
+        }
+        return 1;
+    }
+
     /*# clears a spine skin
      * Clears the current attachments and constraints on a spine skin.
      *
@@ -1045,7 +1240,9 @@ namespace dmSpine
             {"add_skin",                SpineComp_AddSkin},
             {"play_anim",               SpineComp_PlayAnim},
             {"cancel",                  SpineComp_Cancel},
+            {"prefetch_anim",           SpineComp_PrefetchAnim},
             {"get_go",                  SpineComp_GetGO},
+            {"get_bone_transforms",     SpineComp_GetBoneTransforms},
             {"set_skin",                SpineComp_SetSkin},
             {"set_attachment",          SpineComp_SetAttachment},
             {"set_ik_target_position",  SpineComp_SetIKTargetPosition},
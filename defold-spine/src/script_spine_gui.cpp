@@ -12,6 +12,7 @@
 
 #include "script_spine_gui.h"
 #include "gui_node_spine.h"
+#include "gui_spine.h"
 
 // #include "spine_ddf.h"
 // #include "res_spine_model.h"
@@ -732,6 +733,29 @@ namespace dmSpine
         return 1;
     }
 
+    /*# sets the visible area used to cull a spine node
+     * This is only useful for spine nodes. Sets a rectangle, in the coordinate space of the node's parent,
+     * outside of which the node is not rendered. The node's animation still updates while culled.
+     * Useful for spine nodes in scrolling lists, where the rectangle is the list viewport.
+     *
+     * @name gui.set_spine_cull_rect
+     * @param node [type:node] spine node to set the cull rect for
+     * @param rect [type:vector4|nil] visible area as (x, y, width, height), or `nil` to disable culling
+     */
+    static int SetSpineCullRect(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 0);
+
+        dmGui::HScene scene = dmGui::LuaCheckScene(L);
+        dmGui::HNode node = dmGui::LuaCheckNode(L, 1);
+
+        VERIFY_SPINE_NODE(scene, node);
+
+        Vectormath::Aos::Vector4* rect = lua_isnoneornil(L, 2) ? 0 : dmScript::CheckVector4(L, 2);
+        dmSpine::SetCullRect(scene, node, rect);
+        return 0;
+    }
+
     /*# sets a color used to tint all attachments in a slot
      * This is only useful for spine nodes. Sets a tint to a slot on a spine node.
      *
@@ -992,6 +1016,60 @@ namespace dmSpine
         return 0;
     }
 
+    /*# gets the spine statistics of the gui scene
+     * Returns statistics about the spine nodes of the current gui scene, for the last completed frame.
+     *
+     * @name gui.get_spine_stats
+     * @return stats [type:table] table with the following fields:
+     *
+     * `bone_updates`
+     * : [type:number] number of bone nodes whose transform was updated
+     *
+     * `nodes`
+     * : [type:number] number of spine nodes rendered
+     *
+     * `vertices`
+     * : [type:number] number of vertices generated for the spine nodes
+     *
+     * `batch_break_texture`
+     * : [type:number] number of spine nodes that use a different atlas than the spine node drawn before them
+     *
+     * `batch_break_blend_mode`
+     * : [type:number] number of spine nodes that use a different blend mode than the spine node drawn before them
+     *
+     * `batch_break_clipping`
+     * : [type:number] number of spine nodes that are clippers
+     *
+     * `slot_blend_overrides`
+     * : [type:number] number of slots drawn with the blend mode of their node, instead of the blend mode set in Spine
+     */
+    static int GetSpineStats(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 1);
+
+        dmGui::HScene scene = dmGui::LuaCheckScene(L);
+
+        dmSpine::GuiSpineStats stats;
+        dmSpine::GuiSpineGetLastFrameStats(scene, &stats);
+
+        lua_createtable(L, 0, 7);
+        lua_pushinteger(L, stats.m_BoneUpdates);
+        lua_setfield(L, -2, "bone_updates");
+        lua_pushinteger(L, stats.m_Nodes);
+        lua_setfield(L, -2, "nodes");
+        lua_pushinteger(L, stats.m_Vertices);
+        lua_setfield(L, -2, "vertices");
+        lua_pushinteger(L, stats.m_BatchBreakTexture);
+        lua_setfield(L, -2, "batch_break_texture");
+        lua_pushinteger(L, stats.m_BatchBreakBlendMode);
+        lua_setfield(L, -2, "batch_break_blend_mode");
+        lua_pushinteger(L, stats.m_BatchBreakClipping);
+        lua_setfield(L, -2, "batch_break_clipping");
+        lua_pushinteger(L, stats.m_SlotBlendOverrides);
+        lua_setfield(L, -2, "slot_blend_overrides");
+        return 1;
+    }
+
     static const luaL_reg SPINE_FUNCTIONS[] =
     {
         {"new_spine_node", NewSpineNode},
@@ -1010,6 +1088,7 @@ namespace dmSpine
         {"get_spine_cursor",    GetSpineCursor},
         {"set_spine_playback_rate", SetSpinePlaybackRate},
         {"get_spine_playback_rate", GetSpinePlaybackRate},
+        {"set_spine_cull_rect",     SetSpineCullRect},
         {"set_spine_slot_color",    SetSpineSlotColor},
         {"set_spine_attachment",    SetSpineAttachment},
         {"spine_physics_translate", SpineComp_PhysicsTranslate},
@@ -1017,6 +1096,7 @@ namespace dmSpine
         {"set_spine_ik_target_position", SpineComp_SetIKTargetPosition},
         {"set_spine_ik_target",     SpineComp_SetIKTarget},
         {"reset_spine_ik_target",   SpineComp_ResetIK},
+        {"get_spine_stats",         GetSpineStats},
 
         // Also gui.set_spine_attachment to mimic the the go.set_attachment
         {0, 0}
@@ -1,7 +1,12 @@
 #include <assert.h>
 
+#include <dmsdk/dlib/atomic.h>
+#include <dmsdk/dlib/buffer.h>
+#include <dmsdk/dlib/condition_variable.h>
 #include <dmsdk/dlib/hash.h>
 #include <dmsdk/dlib/log.h>
+#include <dmsdk/dlib/mutex.h>
+#include <dmsdk/dlib/thread.h>
 #include <dmsdk/resource/resource.h>
 #include <dmsdk/ddf/ddf.h>
 #include <dmsdk/script/script.h>
@@ -9,12 +14,15 @@
 #include <dmsdk/gamesys/script.h>
 #include <dmsdk/lua/lauxlib.h>
 #include <dmsdk/lua/lua.h>
+#include <dmsdk/gamesys/resources/res_textureset.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "spine_ddf.h"
 
 #include "script_spine_resource.h"
+#include "res_spine_scene.h"
 
 namespace dmSpine
 {
@@ -26,6 +34,37 @@ namespace dmSpine
     static const char* SPINESKEL_EXT = ".skelc";
     static const char* ATLAS_EXT = ".texturesetc";
 
+    // A resource.create_spinescene_async() call. The parsing is done on the worker thread,
+    // and the resource is created on the main thread once it's done.
+    struct CreateSceneJob
+    {
+        dmScript::LuaCallbackInfo*          m_Callback;
+        char*                               m_ScenePath;
+        char*                               m_AtlasPath;
+        char*                               m_SourcePath;   // A file to read on the worker, if the data wasn't supplied
+        void*                               m_Data;
+        uint32_t                            m_DataSize;
+        char                                m_SpineDataPath[2048];
+        SpineSceneResource*                 m_Resource;     // Has the regions when queued, and the parsed scene when done
+        const char*                         m_Error;
+        int32_atomic_t                      m_Done;
+    };
+
+    // The jobs are run one at a time, in the order they were queued, on a single thread.
+    // It's started with the first job, and runs until the module is finalized.
+    struct CreateSceneWorker
+    {
+        dmThread::Thread                        m_Thread;
+        dmMutex::HMutex                         m_Mutex;    // Guards the members below
+        dmConditionVariable::HConditionVariable m_Cond;
+        dmArray<CreateSceneJob*>                m_Queue;    // Not started yet
+        bool                                    m_Quit;
+        bool                                    m_Started;
+    };
+
+    static dmArray<CreateSceneJob*> g_CreateSceneJobs;      // All jobs not yet finished on the main thread
+    static CreateSceneWorker        g_CreateSceneWorker;
+
     static bool HasSuffix(const char* s, const char* suffix)
     {
         size_t ls = strlen(s);
@@ -93,6 +132,52 @@ namespace dmSpine
         return false;
     }
 
+    // The path the spine data is registered with, which decides how it's parsed
+    static void MakeSpineDataPath(const char* scene_path, const int8_t* data, uint32_t data_size, char* out, uint32_t out_size)
+    {
+        const char* spine_data_ext = IsJsonData(data, data_size) ? SPINEJSON_EXT : SPINESKEL_EXT;
+        snprintf(out, out_size, "%s%s", scene_path, spine_data_ext);
+    }
+
+    // Serializes the scene description and creates the resource from it. The backing file is removed again,
+    // and the scene resource is returned with a reference held for the caller.
+    static ResourceResult AddSceneResource(const char* scene_path, const char* spine_data_path, const char* atlas_path, void** out_scene_res)
+    {
+        dmGameSystemDDF::SpineSceneDesc ddf = {};
+        ddf.m_SpineJson = (char*)spine_data_path; // stored/serialized as string
+        ddf.m_Atlas = (char*)atlas_path;
+
+        dmArray<uint8_t> ddf_buffer;
+        dmDDF::Result ddf_res = dmDDF::SaveMessageToArray(&ddf, dmGameSystemDDF::SpineSceneDesc::m_DDFDescriptor, ddf_buffer);
+        if (ddf_res != dmDDF::RESULT_OK)
+        {
+            return RESOURCE_RESULT_INVALID_DATA;
+        }
+
+        ResourceResult result = ResourceAddFile(g_Factory, scene_path, ddf_buffer.Size(), ddf_buffer.Begin());
+        if (result != RESOURCE_RESULT_OK)
+        {
+            return result;
+        }
+        result = ResourceGet(g_Factory, scene_path, out_scene_res);
+        // Remove the spinescene backing file (the resource instance remains alive in memory)
+        dmResource::RemoveFile(g_Factory, scene_path);
+        return result;
+    }
+
+    // Checks the arguments shared by the sync and async versions
+    static void CheckScenePath(lua_State* L, const char* scene_path)
+    {
+        if (!HasSuffix(scene_path, SPINESCENE_EXT))
+        {
+            luaL_error(L, "Unable to create resource, path '%s' must have extension %s", scene_path, SPINESCENE_EXT);
+        }
+        if (scene_path[0] != '/')
+        {
+            luaL_error(L, "'path' must be an absolute resource path starting with '/'");
+        }
+    }
+
     /*# Creates a spinescene resource (.spinescenec) from runtime data
      *
      * Creates a Spine scene resource dynamically at runtime. This allows loading
@@ -137,14 +222,7 @@ namespace dmSpine
 
         const char* scene_path = luaL_checkstring(L, 1);
         // Validate extension and absolute path
-        if (!HasSuffix(scene_path, SPINESCENE_EXT))
-        {
-            return luaL_error(L, "Unable to create resource, path '%s' must have extension %s", scene_path, SPINESCENE_EXT);
-        }
-        if (scene_path[0] != '/')
-        {
-            return luaL_error(L, "'path' must be an absolute resource path starting with '/'");
-        }
+        CheckScenePath(L, scene_path);
 
         // Remove any stale registered file for this path (safe if none exists)
         dmResource::RemoveFile(g_Factory, scene_path);
@@ -200,78 +278,38 @@ namespace dmSpine
         lua_pop(L, 1); // atlas_path
         lua_pop(L, 1); // options
 
-        // Create a child resource using the type matching the supplied data.
-        const char* spine_data_ext = IsJsonData(spine_data, spine_data_size) ? SPINEJSON_EXT : SPINESKEL_EXT;
+        // The path decides how the data is parsed
         char spine_data_path[2048];
-        size_t scene_path_len = strlen(scene_path);
-        size_t spine_data_path_len = scene_path_len + strlen(spine_data_ext) + 1;
-        if (spine_data_path_len > sizeof(spine_data_path))
-            spine_data_path_len = sizeof(spine_data_path);
-        snprintf(spine_data_path, spine_data_path_len, "%s%s", scene_path, spine_data_ext);
-        // Ensure any stale intermediate file is cleared first
-        dmResource::RemoveFile(g_Factory, spine_data_path);
-
-        // Ensure no collision
-        HResourceDescriptor tmp;
-        if (ResourceGetDescriptor(g_Factory, spine_data_path, &tmp) == RESOURCE_RESULT_OK)
-        {
-            return luaL_error(L, "Unable to create resource, a resource is already registered at path '%s'", spine_data_path);
-        }
-
-        // Register the Spine data payload as a file and load it.
-        ResourceResult add_spine_data = ResourceAddFile(g_Factory, spine_data_path, spine_data_size, (void*)spine_data);
-        if (add_spine_data != RESOURCE_RESULT_OK)
-        {
-            return luaL_error(L, "Failed to add intermediate Spine data resource '%s' (error %d)", spine_data_path, add_spine_data);
-        }
-        void* out_spine_data_res = 0;
-        ResourceResult get_spine_data = ResourceGet(g_Factory, spine_data_path, &out_spine_data_res);
-        if (get_spine_data != RESOURCE_RESULT_OK)
-        {
-            // Clean up the added file if loading failed
-            dmResource::RemoveFile(g_Factory, spine_data_path);
-            return luaL_error(L, "Failed to load intermediate Spine data resource '%s' (error %d)", spine_data_path, get_spine_data);
-        }
+        MakeSpineDataPath(scene_path, spine_data, spine_data_size, spine_data_path, sizeof(spine_data_path));
 
-        // Build DDF for spinescenec
-        dmGameSystemDDF::SpineSceneDesc ddf = {};
-        ddf.m_SpineJson = (char*)spine_data_path; // stored/serialized as string
-        // Validate atlas resource exists
+        // The texture set is only needed while the regions are created
         void* atlas_res = 0;
         ResourceResult atlas_result = ResourceGet(g_Factory, atlas_path, &atlas_res);
         if (atlas_result != RESOURCE_RESULT_OK)
         {
-            dmResource::Release(g_Factory, out_spine_data_res);
             return luaL_error(L, "'atlas_path' must reference a valid atlas resource (%s)", ATLAS_EXT);
         }
-        // Release atlas resource - we only needed to validate it exists
-        dmResource::Release(g_Factory, atlas_res);
-        ddf.m_Atlas = (char*)atlas_path;
 
-        dmArray<uint8_t> ddf_buffer;
-        dmDDF::Result ddf_res = dmDDF::SaveMessageToArray(&ddf, dmGameSystemDDF::SpineSceneDesc::m_DDFDescriptor, ddf_buffer);
-        if (ddf_res != dmDDF::RESULT_OK)
+        // We parse a single copy of the data, which the resource takes ownership of, the same way
+        // the async version does. There's no intermediate spine data resource holding another copy.
+        void* data = malloc(spine_data_size);
+        memcpy(data, spine_data, spine_data_size);
+        SpineSceneResource* prepared = PrepareSceneResource(g_Factory, atlas_path, ((dmGameSystem::TextureSetResource*)atlas_res)->m_TextureSet,
+                                                            spine_data_path, data, spine_data_size);
+        dmResource::Release(g_Factory, atlas_res);
+        if (!prepared)
         {
-            dmResource::Release(g_Factory, out_spine_data_res);
-            return luaL_error(L, "Failed to serialize SpineSceneDesc");
+            return luaL_error(L, "Failed to parse the Spine data for '%s'", scene_path);
         }
 
-        // Add spinescene file data and load resource
-        ResourceResult add_scene = ResourceAddFile(g_Factory, scene_path, ddf_buffer.Size(), ddf_buffer.Begin());
-        if (add_scene != RESOURCE_RESULT_OK)
-        {
-            dmResource::Release(g_Factory, out_spine_data_res);
-            dmResource::RemoveFile(g_Factory, spine_data_path);
-            return luaL_error(L, "Failed to add spinescene resource '%s' (error %d)", scene_path, add_scene);
-        }
+        // The resource type picks up the prepared data, instead of loading the spine data path
+        AddPreparedSceneResource(g_Factory, spine_data_path, prepared);
+
         void* out_scene_res = 0;
-        ResourceResult get_scene = ResourceGet(g_Factory, scene_path, &out_scene_res);
+        ResourceResult get_scene = AddSceneResource(scene_path, spine_data_path, atlas_path, &out_scene_res);
         if (get_scene != RESOURCE_RESULT_OK)
         {
-            // Clean up both added files if final loading failed
-            dmResource::RemoveFile(g_Factory, scene_path);
-            dmResource::Release(g_Factory, out_spine_data_res);
-            dmResource::RemoveFile(g_Factory, spine_data_path);
+            RemovePreparedSceneResource(g_Factory, spine_data_path);
             return luaL_error(L, "Failed to load spinescene resource '%s' (error %d)", scene_path, get_scene);
         }
 
@@ -281,16 +319,9 @@ namespace dmSpine
         // Get collection for automatic resource cleanup (works from both .script and .gui_script)
         dmGameObject::HCollection collection = dmScript::CheckCollection(L);
 
-        // Register only the scene resource for automatic cleanup
-        // (The Spine data resource is intermediate and will be released immediately.)
+        // Register the scene resource for automatic cleanup
         dmGameObject::AddDynamicResourceHash(collection, canonical_hash);
 
-        // Release and remove the intermediate Spine data resource (no longer needed after scene loaded).
-        dmResource::Release(g_Factory, out_spine_data_res);
-        dmResource::RemoveFile(g_Factory, spine_data_path);
-        // Remove the spinescene backing file (resource instance remains alive in memory)
-        dmResource::RemoveFile(g_Factory, scene_path);
-        
         // Note: Don't release out_scene_res! That's the resource the caller will use
         // The reference count from ResourceGet() stays to keep the resource alive
 
@@ -298,9 +329,324 @@ namespace dmSpine
         return 1;
     }
 
+    static void DeleteCreateSceneJob(CreateSceneJob* job)
+    {
+        if (job->m_Callback)
+            dmScript::DestroyCallback(job->m_Callback);
+        if (job->m_Resource)
+            DeletePreparedSceneResource(g_Factory, job->m_Resource);
+        free(job->m_Data);
+        free(job->m_ScenePath);
+        free(job->m_AtlasPath);
+        free(job->m_SourcePath);
+        delete job;
+    }
+
+    static void* ReadSourceFile(const char* path, uint32_t* out_size)
+    {
+        FILE* file = fopen(path, "rb");
+        if (!file)
+            return 0;
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        void* data = size > 0 ? malloc(size) : 0;
+        if (data && fread(data, 1, size, file) != (size_t)size)
+        {
+            free(data);
+            data = 0;
+        }
+        fclose(file);
+        *out_size = (uint32_t)size;
+        return data;
+    }
+
+    // Runs on the worker thread. Only touches the job, and the resource data while it's being prepared.
+    static void RunCreateSceneJob(CreateSceneJob* job)
+    {
+        if (job->m_SourcePath)
+        {
+            job->m_Data = ReadSourceFile(job->m_SourcePath, &job->m_DataSize);
+            if (!job->m_Data)
+                job->m_Error = "Failed to read the spine data file";
+        }
+
+        if (job->m_Data)
+        {
+            MakeSpineDataPath(job->m_ScenePath, (const int8_t*)job->m_Data, job->m_DataSize, job->m_SpineDataPath, sizeof(job->m_SpineDataPath));
+
+            // The data is owned by the resource from here on
+            void* data = job->m_Data;
+            job->m_Data = 0;
+            if (!ParsePreparedSceneResource(g_Factory, job->m_Resource, job->m_SpineDataPath, data, job->m_DataSize))
+                job->m_Error = "Failed to parse the spine data";
+        }
+
+        dmAtomicStore32(&job->m_Done, 1);
+    }
+
+    static void CreateSceneWorkerThread(void* arg)
+    {
+        CreateSceneWorker* worker = (CreateSceneWorker*)arg;
+        dmMutex::Lock(worker->m_Mutex);
+        while (true)
+        {
+            while (!worker->m_Quit && worker->m_Queue.Empty())
+                dmConditionVariable::Wait(worker->m_Cond, worker->m_Mutex);
+            if (worker->m_Quit)
+                break;
+
+            CreateSceneJob* job = worker->m_Queue[0];
+            for (uint32_t i = 1; i < worker->m_Queue.Size(); ++i)
+                worker->m_Queue[i - 1] = worker->m_Queue[i];
+            worker->m_Queue.Pop();
+
+            dmMutex::Unlock(worker->m_Mutex);
+            RunCreateSceneJob(job);
+            dmMutex::Lock(worker->m_Mutex);
+        }
+        dmMutex::Unlock(worker->m_Mutex);
+    }
+
+    static void QueueCreateSceneJob(CreateSceneJob* job)
+    {
+        CreateSceneWorker* worker = &g_CreateSceneWorker;
+        if (!worker->m_Started)
+        {
+            worker->m_Mutex = dmMutex::New();
+            worker->m_Cond = dmConditionVariable::New();
+            worker->m_Quit = false;
+            worker->m_Started = true;
+            worker->m_Thread = dmThread::New(CreateSceneWorkerThread, 0x80000, worker, "spine_load");
+        }
+
+        DM_MUTEX_SCOPED_LOCK(worker->m_Mutex);
+        if (worker->m_Queue.Full())
+            worker->m_Queue.OffsetCapacity(4);
+        worker->m_Queue.Push(job);
+        dmConditionVariable::Signal(worker->m_Cond);
+    }
+
+    // Jobs that haven't started are dropped
+    static void StopCreateSceneWorker()
+    {
+        CreateSceneWorker* worker = &g_CreateSceneWorker;
+        if (!worker->m_Started)
+            return;
+
+        dmMutex::Lock(worker->m_Mutex);
+        worker->m_Quit = true;
+        worker->m_Queue.SetSize(0);
+        dmConditionVariable::Signal(worker->m_Cond);
+        dmMutex::Unlock(worker->m_Mutex);
+
+        dmThread::Join(worker->m_Thread);
+        dmConditionVariable::Delete(worker->m_Cond);
+        dmMutex::Delete(worker->m_Mutex);
+        worker->m_Started = false;
+    }
+
+    // Creates the resource from the prepared data. Returns an error message on failure.
+    static const char* FinishCreateSceneJob(lua_State* L, CreateSceneJob* job, dmhash_t* out_path_hash)
+    {
+        if (job->m_Error)
+            return job->m_Error;
+
+        // The path may have been taken while we were parsing
+        void* existing_scene_res = 0;
+        dmResource::RemoveFile(g_Factory, job->m_ScenePath);
+        if (ResourceGet(g_Factory, job->m_ScenePath, &existing_scene_res) == RESOURCE_RESULT_OK)
+        {
+            dmResource::Release(g_Factory, existing_scene_res);
+            return "A resource is already loaded at the path";
+        }
+
+        // The resource type picks up the prepared data, instead of loading the spine data path
+        AddPreparedSceneResource(g_Factory, job->m_SpineDataPath, job->m_Resource);
+        job->m_Resource = 0;
+
+        void* out_scene_res = 0;
+        if (AddSceneResource(job->m_ScenePath, job->m_SpineDataPath, job->m_AtlasPath, &out_scene_res) != RESOURCE_RESULT_OK)
+        {
+            RemovePreparedSceneResource(g_Factory, job->m_SpineDataPath);
+            return "Failed to create the spinescene resource";
+        }
+
+        ResourceGetPath(g_Factory, out_scene_res, out_path_hash);
+        dmGameObject::HCollection collection = dmScript::CheckCollection(L);
+        dmGameObject::AddDynamicResourceHash(collection, *out_path_hash);
+        return 0;
+    }
+
+    static void RunCreateSceneCallback(CreateSceneJob* job)
+    {
+        if (!dmScript::IsCallbackValid(job->m_Callback))
+        {
+            // The script is gone, so there's no one to hand the resource to
+            return;
+        }
+        lua_State* L = dmScript::GetCallbackLuaContext(job->m_Callback);
+        DM_LUA_STACK_CHECK(L, 0);
+
+        if (!dmScript::SetupCallback(job->m_Callback))
+        {
+            dmLogError("Failed to setup spinescene creation callback");
+            return;
+        }
+
+        dmhash_t path_hash = 0;
+        const char* error = FinishCreateSceneJob(L, job, &path_hash);
+        if (error)
+        {
+            lua_pushnil(L);
+            lua_pushfstring(L, "%s: '%s'", error, job->m_ScenePath);
+        }
+        else
+        {
+            dmScript::PushHash(L, path_hash);
+            lua_pushnil(L);
+        }
+        dmScript::PCall(L, 3, 0);
+        dmScript::TeardownCallback(job->m_Callback);
+    }
+
+    /*# Creates a spinescene resource (.spinescenec) from runtime data, without blocking
+     *
+     * Same as resource.create_spinescene(), except that the spine data is parsed on a
+     * worker thread, one call at a time. The data may be given as a string or a buffer
+     * (which is copied once), or read from a file by the thread. The resource is created,
+     * and the callback is called, on the main thread once the parsing is done.
+     *
+     * @name resource.create_spinescene_async
+     * @param path [type:string] The target resource path. Must end with .spinescenec
+     * @param options [type:table] Table with fields:
+     *  - spine_data [type:string|buffer] JSON or binary bytes of the Spine skeleton
+     *  - spine_file [type:string] Or, a file to read the Spine skeleton from (e.g. a downloaded file)
+     *  - atlas_path [type:string] Path to the compiled atlas resource (.texturesetc)
+     * @param callback [type:function(self, path_hash, error)] Called when the resource is created, or failed to be created.
+     *  - path_hash [type:hash|nil] canonical path hash of the created resource
+     *  - error [type:string|nil] the error message on failure
+     *
+     * @examples
+     * ```lua
+     * function init(self)
+     *     local path = sys.get_save_file("mygame", "character.skel")
+     *     resource.create_spinescene_async("/dyn/character.spinescenec", {
+     *         spine_file = path,
+     *         atlas_path = "/textures/character.a.texturesetc"
+     *     }, function(self, scene, error)
+     *         if scene then
+     *             go.set("#spine", "spine_scene", scene)
+     *         else
+     *             print(error)
+     *         end
+     *     end)
+     * end
+     * ```
+     */
+    static int CreateSpineSceneAsync(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 0);
+
+        if (g_Factory == 0)
+        {
+            return luaL_error(L, "Spine resource module not initialized");
+        }
+
+        const char* scene_path = luaL_checkstring(L, 1);
+        CheckScenePath(L, scene_path);
+        luaL_checktype(L, 2, LUA_TTABLE);
+        luaL_checktype(L, 3, LUA_TFUNCTION);
+
+        const char* spine_data = 0;
+        uint32_t spine_data_size = 0;
+        const char* spine_file = 0;
+
+        lua_getfield(L, 2, "spine_data");
+        if (lua_isstring(L, -1))
+        {
+            size_t string_len;
+            spine_data = lua_tolstring(L, -1, &string_len);
+            spine_data_size = (uint32_t)string_len;
+        }
+        else if (dmScript::IsBuffer(L, -1))
+        {
+            dmBuffer::HBuffer buffer = dmScript::CheckBufferUnpack(L, -1);
+            void* bytes = 0;
+            if (dmBuffer::GetBytes(buffer, &bytes, &spine_data_size) != dmBuffer::RESULT_OK)
+            {
+                lua_pop(L, 1);
+                return luaL_error(L, "Failed to get the bytes of 'spine_data'");
+            }
+            spine_data = (const char*)bytes;
+        }
+        else if (!lua_isnil(L, -1))
+        {
+            lua_pop(L, 1);
+            return luaL_error(L, "Expected 'string' or 'buffer' for 'spine_data'");
+        }
+        lua_pop(L, 1);
+
+        lua_getfield(L, 2, "spine_file");
+        if (lua_isstring(L, -1))
+            spine_file = lua_tostring(L, -1);
+        lua_pop(L, 1);
+
+        if (!spine_data && !spine_file)
+        {
+            return luaL_error(L, "Missing required field 'spine_data' or 'spine_file'");
+        }
+        if (spine_data && spine_data_size == 0)
+        {
+            return luaL_error(L, "'spine_data' is empty");
+        }
+
+        lua_getfield(L, 2, "atlas_path");
+        const char* atlas_path = lua_isstring(L, -1) ? lua_tostring(L, -1) : 0;
+        lua_pop(L, 1);
+        if (!atlas_path || atlas_path[0] != '/')
+        {
+            return luaL_error(L, "'atlas_path' must be an absolute resource path starting with '/'");
+        }
+
+        // The regions are copied here, as the texture set may be replaced (e.g. with resource.set_atlas) while the worker parses
+        void* atlas_res = 0;
+        if (ResourceGet(g_Factory, atlas_path, &atlas_res) != RESOURCE_RESULT_OK)
+        {
+            return luaL_error(L, "'atlas_path' must reference a valid atlas resource (%s)", ATLAS_EXT);
+        }
+
+        CreateSceneJob* job = new CreateSceneJob();
+        job->m_Resource = NewPreparedSceneResource(atlas_path, ((dmGameSystem::TextureSetResource*)atlas_res)->m_TextureSet);
+        dmResource::Release(g_Factory, atlas_res);
+        job->m_ScenePath = strdup(scene_path);
+        job->m_AtlasPath = strdup(atlas_path);
+        if (spine_data)
+        {
+            // The only copy of the data, which the resource takes ownership of
+            job->m_Data = malloc(spine_data_size);
+            memcpy(job->m_Data, spine_data, spine_data_size);
+            job->m_DataSize = spine_data_size;
+        }
+        else
+        {
+            job->m_SourcePath = strdup(spine_file);
+        }
+        job->m_Callback = dmScript::CreateCallback(L, 3);
+        dmAtomicStore32(&job->m_Done, 0);
+
+        if (g_CreateSceneJobs.Full())
+            g_CreateSceneJobs.OffsetCapacity(4);
+        g_CreateSceneJobs.Push(job);
+        QueueCreateSceneJob(job);
+        return 0;
+    }
+
     static const luaL_reg MODULE_FUNCTIONS[] =
     {
         {"create_spinescene", CreateSpineScene},
+        {"create_spinescene_async", CreateSpineSceneAsync},
         {0, 0}
     };
 
@@ -309,6 +655,33 @@ namespace dmSpine
         g_Factory = factory;
     }
 
+    void ScriptSpineResourceUpdate()
+    {
+        for (uint32_t i = 0; i < g_CreateSceneJobs.Size();)
+        {
+            CreateSceneJob* job = g_CreateSceneJobs[i];
+            if (!dmAtomicGet32(&job->m_Done))
+            {
+                ++i;
+                continue;
+            }
+            g_CreateSceneJobs.EraseSwap(i);
+
+            RunCreateSceneCallback(job);
+            DeleteCreateSceneJob(job);
+        }
+    }
+
+    void ScriptSpineResourceFinalize()
+    {
+        // The callbacks are dropped, as the scripts are going away
+        StopCreateSceneWorker();
+        for (uint32_t i = 0; i < g_CreateSceneJobs.Size(); ++i)
+            DeleteCreateSceneJob(g_CreateSceneJobs[i]);
+        g_CreateSceneJobs.SetSize(0);
+        g_Factory = 0;
+    }
+
     void ScriptSpineResourceRegister(lua_State* L)
     {
         luaL_register(L, "resource", MODULE_FUNCTIONS);
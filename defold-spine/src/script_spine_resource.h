@@ -6,6 +6,10 @@
 namespace dmSpine
 {
     void ScriptSpineResourceInitialize(dmResource::HFactory factory);
+    // Finishes the resource.create_spinescene_async() calls whose parsing is done
+    void ScriptSpineResourceUpdate();
+    // Waits for any pending parsing, and drops the results
+    void ScriptSpineResourceFinalize();
     void ScriptSpineResourceRegister(struct lua_State* L);
 }
 